@@ -0,0 +1,48 @@
+#include "FWCore/Framework/interface/global/EDProducer.h"
+#include "FWCore/Framework/interface/MakerMacros.h"
+#include "FWCore/Framework/interface/Event.h"
+#include "FWCore/ParameterSet/interface/ParameterSet.h"
+#include "FWCore/ParameterSet/interface/ConfigurationDescriptions.h"
+#include "FWCore/ParameterSet/interface/ParameterSetDescription.h"
+
+#include "DataFormats/TrackReco/interface/Track.h"
+#include "DataFormats/TrackReco/interface/TrackFwd.h"
+#include "DataFormats/TrackReco/interface/TrackSoA.h"
+
+/**
+ * Rebuilds a reco::TrackCollection from a reco::TrackSoA, for the
+ * consumers which still need reco::Tracks. The tracks have no TrackExtra.
+ */
+class TrackFromSoAProducer: public edm::global::EDProducer<> {
+public:
+  TrackFromSoAProducer(const edm::ParameterSet& iConfig);
+
+  static void fillDescriptions(edm::ConfigurationDescriptions& descriptions);
+
+  void produce(edm::StreamID, edm::Event& iEvent, const edm::EventSetup& iSetup) const override;
+
+private:
+  const edm::EDGetTokenT<reco::TrackSoA> tracksToken_;
+  const edm::EDPutTokenT<reco::TrackCollection> putToken_;
+};
+
+
+TrackFromSoAProducer::TrackFromSoAProducer(const edm::ParameterSet& iConfig):
+  tracksToken_(consumes<reco::TrackSoA>(iConfig.getParameter<edm::InputTag>("src"))),
+  putToken_(produces<reco::TrackCollection>())
+{}
+
+void TrackFromSoAProducer::fillDescriptions(edm::ConfigurationDescriptions& descriptions) {
+  edm::ParameterSetDescription desc;
+  desc.add<edm::InputTag>("src", edm::InputTag("trackSoAProducer"));
+  descriptions.add("trackFromSoAProducer", desc);
+}
+
+void TrackFromSoAProducer::produce(edm::StreamID, edm::Event& iEvent, const edm::EventSetup& iSetup) const {
+  edm::Handle<reco::TrackSoA> h_tracks;
+  iEvent.getByToken(tracksToken_, h_tracks);
+
+  iEvent.emplace(putToken_, h_tracks->tracks());
+}
+
+DEFINE_FWK_MODULE(TrackFromSoAProducer);
@@ -0,0 +1,49 @@
+#include "FWCore/Framework/interface/global/EDProducer.h"
+#include "FWCore/Framework/interface/MakerMacros.h"
+#include "FWCore/Framework/interface/Event.h"
+#include "FWCore/ParameterSet/interface/ParameterSet.h"
+#include "FWCore/ParameterSet/interface/ConfigurationDescriptions.h"
+#include "FWCore/ParameterSet/interface/ParameterSetDescription.h"
+
+#include "DataFormats/TrackReco/interface/Track.h"
+#include "DataFormats/TrackReco/interface/TrackFwd.h"
+#include "DataFormats/TrackReco/interface/TrackSoA.h"
+
+/**
+ * Converts a reco::TrackCollection to a reco::TrackSoA, which stores the
+ * track parameters column by column. The rows are in the order of the
+ * input collection, so row i corresponds to reco::TrackRef(tracks, i).
+ */
+class TrackSoAProducer: public edm::global::EDProducer<> {
+public:
+  TrackSoAProducer(const edm::ParameterSet& iConfig);
+
+  static void fillDescriptions(edm::ConfigurationDescriptions& descriptions);
+
+  void produce(edm::StreamID, edm::Event& iEvent, const edm::EventSetup& iSetup) const override;
+
+private:
+  const edm::EDGetTokenT<reco::TrackCollection> tracksToken_;
+  const edm::EDPutTokenT<reco::TrackSoA> putToken_;
+};
+
+
+TrackSoAProducer::TrackSoAProducer(const edm::ParameterSet& iConfig):
+  tracksToken_(consumes<reco::TrackCollection>(iConfig.getParameter<edm::InputTag>("src"))),
+  putToken_(produces<reco::TrackSoA>())
+{}
+
+void TrackSoAProducer::fillDescriptions(edm::ConfigurationDescriptions& descriptions) {
+  edm::ParameterSetDescription desc;
+  desc.add<edm::InputTag>("src", edm::InputTag("generalTracks"));
+  descriptions.add("trackSoAProducer", desc);
+}
+
+void TrackSoAProducer::produce(edm::StreamID, edm::Event& iEvent, const edm::EventSetup& iSetup) const {
+  edm::Handle<reco::TrackCollection> h_tracks;
+  iEvent.getByToken(tracksToken_, h_tracks);
+
+  iEvent.emplace(putToken_, *h_tracks);
+}
+
+DEFINE_FWK_MODULE(TrackSoAProducer);
@@ -11,11 +11,15 @@ namespace reco {
     template<typename T, bool Lazy>
     struct ParameterAdapter<StringCutObjectSelector<T, Lazy> > {
       static StringCutObjectSelector<T, Lazy> make( const edm::ParameterSet & cfg, edm::ConsumesCollector & iC ) {
-	return StringCutObjectSelector<T, Lazy>( cfg.template getParameter<std::string>( "cut" ) );
+	return StringCutObjectSelector<T, Lazy>( cfg.template getParameter<std::string>( "cut" ), Lazy,
+						 cfg.template getUntrackedParameter<std::string>( "compileCut", "" ) );
       }
 
       static void fillPSetDescription(edm::ParameterSetDescription& desc) {
         desc.add<std::string>("cut", "");
+        desc.addUntracked<std::string>("compileCut", "")->setComment(
+          "package whose src/precompile.h declares the selected type, to compile the cut to C++ "
+          "(see CommonTools/Utils/interface/compiledExpression.h); empty to evaluate it through reflection");
       }
     };
 
@@ -31,7 +35,8 @@ namespace reco{
     class StringCutObjectSelectorHandler : public StringCutObjectSelector<T,Lazy>  {
     public:
       explicit StringCutObjectSelectorHandler( const edm::ParameterSet & cfg ) :
-        StringCutObjectSelector<T, Lazy>(cfg.getParameter<std::string>("cut"))
+        StringCutObjectSelector<T, Lazy>(cfg.getParameter<std::string>("cut"), Lazy,
+                                         cfg.getUntrackedParameter<std::string>("compileCut", ""))
       {
       }
   };
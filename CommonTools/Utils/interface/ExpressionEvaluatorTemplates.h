@@ -6,6 +6,7 @@
 #include<limits>
 #include<memory>
 #include<tuple>
+#include<cmath>
 
 namespace reco {
 
@@ -10,7 +10,10 @@
 #include "CommonTools/Utils/src/SelectorPtr.h"
 #include "CommonTools/Utils/src/SelectorBase.h"
 #include "CommonTools/Utils/interface/cutParser.h"
+#include "CommonTools/Utils/interface/compiledExpression.h"
 #include "FWCore/Utilities/interface/ObjectWithDict.h"
+#include <memory>
+#include <vector>
 
 template<typename T, bool DefaultLazyness=false>
 struct StringCutObjectSelector {
@@ -21,18 +24,44 @@ struct StringCutObjectSelector {
 			   "failed to parse \"" + cut + "\"");
     }
   }
+  /// opt-in: also compiles the cut to C++ against <compilePackage>/src/precompile.h, which must declare T
+  /// (see compiledExpression.h); the reflection based selection is used if this is not possible
+  /// or if compilePackage is empty
+  StringCutObjectSelector(const std::string & cut, bool lazy, const std::string & compilePackage) :
+    StringCutObjectSelector(cut, lazy) {
+    if(!compilePackage.empty()) compiled_ = reco::parser::compiledCut<T>(compilePackage, type_.name(), cut);
+  }
   StringCutObjectSelector(const reco::parser::SelectorPtr & select) : 
     select_(select),
     type_(typeid(T)) {
   }
   bool operator()(const T & t) const {
+    if(compiled_) return compiled_->eval(t);
     edm::ObjectWithDict o(type_, const_cast<T *>(& t));
     return (*select_)(o);  
   }
+  /// selects all the objects at once: out[i] is (*this)(*objs[i]). The parsed cut is evaluated
+  /// column by column, each method being called for all the objects before the next one
+  template<typename Out>
+  void evaluate(const std::vector<const T *> & objs, std::vector<Out> & out) const {
+    const size_t n = objs.size();
+    out.resize(n);
+    if(compiled_) {
+      for(size_t i = 0; i != n; ++i) out[i] = compiled_->eval(*objs[i]);
+      return;
+    }
+    std::vector<edm::ObjectWithDict> os;
+    os.reserve(n);
+    for(const T * t : objs) os.emplace_back(type_, const_cast<T *>(t));
+    std::unique_ptr<bool[]> selected(new bool[n]);
+    select_->select(os, selected.get());
+    for(size_t i = 0; i != n; ++i) out[i] = selected[i];
+  }
 
 private:
   reco::parser::SelectorPtr select_;
   edm::TypeWithDict type_;
+  reco::CutOnObject<T> const* compiled_ = nullptr;
 };
 
 #endif
@@ -10,7 +10,10 @@
 #include "CommonTools/Utils/src/ExpressionPtr.h"
 #include "CommonTools/Utils/src/ExpressionBase.h"
 #include "CommonTools/Utils/interface/expressionParser.h"
+#include "CommonTools/Utils/interface/compiledExpression.h"
 #include "FWCore/Utilities/interface/ObjectWithDict.h"
+#include <algorithm>
+#include <vector>
 
 template<typename T, bool DefaultLazyness=false>
 struct StringObjectFunction {
@@ -21,18 +24,44 @@ struct StringObjectFunction {
 			   "failed to parse \"" + expr + "\"");
     }
   }
+  /// opt-in: also compiles the expression to C++ against <compilePackage>/src/precompile.h, which must declare T
+  /// (see compiledExpression.h); the reflection based evaluation is used if this is not possible
+  /// or if compilePackage is empty
+  StringObjectFunction(const std::string & expr, bool lazy, const std::string & compilePackage) :
+    StringObjectFunction(expr, lazy) {
+    if(!compilePackage.empty()) compiled_ = reco::parser::compiledFunction<T>(compilePackage, type_.name(), expr);
+  }
   StringObjectFunction(const reco::parser::ExpressionPtr & expr) : 
     expr_(expr),
     type_(typeid(T)) {
   }
   double operator()(const T & t) const {
+    if(compiled_) return compiled_->eval(t);
     edm::ObjectWithDict o(type_, const_cast<T *>(& t));
     return expr_->value(o);  
   }
+  /// evaluates the expression for all the objects at once: out[i] is (*this)(*objs[i]). The parsed
+  /// expression is evaluated column by column, each method being called for all the objects before the next one
+  template<typename Out>
+  void evaluate(const std::vector<const T *> & objs, std::vector<Out> & out) const {
+    const size_t n = objs.size();
+    out.resize(n);
+    if(compiled_) {
+      for(size_t i = 0; i != n; ++i) out[i] = compiled_->eval(*objs[i]);
+      return;
+    }
+    std::vector<edm::ObjectWithDict> os;
+    os.reserve(n);
+    for(const T * t : objs) os.emplace_back(type_, const_cast<T *>(t));
+    std::vector<double> values(n);
+    expr_->values(os, values.data());
+    std::copy(values.begin(), values.end(), out.begin());
+  }
 
 private:
   reco::parser::ExpressionPtr expr_;
   edm::TypeWithDict type_;
+  reco::ValueOnObject<T> const* compiled_ = nullptr;
 };
 
 template <typename Object> class sortByStringFunction  {
@@ -0,0 +1,58 @@
+#ifndef CommonTools_Utils_compiledExpression_h
+#define CommonTools_Utils_compiledExpression_h
+/* Compiled versions of the StringCutObjectSelector and StringObjectFunction expressions
+ *
+ * The string is translated to C++ and compiled with the ExpressionEvaluator against the precompiled
+ * header of a package (<package>/src/precompile.h), which must declare the object type and include
+ * ExpressionEvaluatorTemplates.h. Every distinct expression is compiled only once per process.
+ *
+ * Only the constructs with a direct C++ equivalent are translated: chains of methods taking literal
+ * arguments, arithmetic, comparisons, logical operators and the usual math functions. The result is
+ * nullptr whenever the translation or the compilation is not possible, the caller then has to keep
+ * using the reflection based evaluation, which must have been parsed successfully beforehand.
+ */
+#include "CommonTools/Utils/interface/ExpressionEvaluator.h"
+#include "CommonTools/Utils/interface/ExpressionEvaluatorTemplates.h"
+
+#include <string>
+
+namespace reco {
+  namespace parser {
+
+    /// Writes in cpp the C++ equivalent of expr, as a function of the object "o".
+    /// Returns false if expr uses a construct with no direct translation
+    bool expressionToCpp(const std::string& expr, std::string& cpp);
+
+    typedef void const* (*CompiledExpressionGetter)(ExpressionEvaluator const&);
+
+    /// Compiles, or takes from the process wide cache, a class deriving from base with the given body.
+    /// Returns nullptr if the compilation failed
+    void const* compiledExpression(const std::string& pkg, const std::string& base, const std::string& body,
+                                   CompiledExpressionGetter getter);
+
+    template<typename T>
+    CutOnObject<T> const* compiledCut(const std::string& pkg, const std::string& typeName, const std::string& cut) {
+      std::string cpp;
+      if (!expressionToCpp(cut, cpp)) return nullptr;
+      std::string base = "reco::CutOnObject<" + typeName + ">";
+      std::string body = "bool eval(" + typeName + " const& o) const override { return " + cpp + "; }";
+      return static_cast<CutOnObject<T> const*>(
+          compiledExpression(pkg, base, body,
+                             [](ExpressionEvaluator const& ee) -> void const* { return ee.expr<CutOnObject<T> >(); }));
+    }
+
+    template<typename T>
+    ValueOnObject<T> const* compiledFunction(const std::string& pkg, const std::string& typeName, const std::string& expr) {
+      std::string cpp;
+      if (!expressionToCpp(expr, cpp)) return nullptr;
+      std::string base = "reco::ValueOnObject<" + typeName + ">";
+      std::string body = "double eval(" + typeName + " const& o) const override { return " + cpp + "; }";
+      return static_cast<ValueOnObject<T> const*>(
+          compiledExpression(pkg, base, body,
+                             [](ExpressionEvaluator const& ee) -> void const* { return ee.expr<ValueOnObject<T> >(); }));
+    }
+
+  }
+}
+
+#endif
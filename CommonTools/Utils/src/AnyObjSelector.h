@@ -1,11 +1,15 @@
 #ifndef CommonTools_Utils_AnyObjSelector_h
 #define CommonTools_Utils_AnyObjSelector_h
 #include "CommonTools/Utils/src/SelectorBase.h"
+#include <algorithm>
 
 namespace reco {
   namespace parser {
     class AnyObjSelector : public SelectorBase {
       bool operator()(const edm::ObjectWithDict & c) const override { return true; }
+      void select(const std::vector<edm::ObjectWithDict> & objs, bool * out) const override {
+        std::fill(out, out + objs.size(), true);
+      }
     };
   }
 }
@@ -25,6 +25,13 @@ namespace reco {
       bool operator()( const edm::ObjectWithDict & o ) const override {
 	return cmp_->compare( lhs_->value( o ), rhs_->value( o ) );
       }
+      void select( const std::vector<edm::ObjectWithDict> & objs, bool * out ) const override {
+	const size_t n = objs.size();
+	std::vector<double> lhs( n ), rhs( n );
+	lhs_->values( objs, lhs.data() );
+	rhs_->values( objs, rhs.data() );
+	cmp_->compare( lhs.data(), rhs.data(), out, n );
+      }
       boost::shared_ptr<ExpressionBase> lhs_;
       boost::shared_ptr<ComparisonBase> cmp_;
       boost::shared_ptr<ExpressionBase> rhs_;
@@ -17,6 +17,9 @@ namespace reco {
     template<class CompT>
     struct Comparison : public ComparisonBase {
       bool compare(double lhs, double rhs) const override { return comp(lhs, rhs); }
+      void compare(const double * lhs, const double * rhs, bool * out, size_t n) const override {
+        for(size_t i = 0; i != n; ++i) out[i] = comp(lhs[i], rhs[i]);
+      }
     private:
       CompT comp;
     };
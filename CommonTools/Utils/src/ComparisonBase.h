@@ -10,12 +10,16 @@
  * \version $Revision: 1.2 $
  *
  */
+#include <cstddef>
 
 namespace reco {
   namespace parser {
     struct ComparisonBase {
       virtual ~ComparisonBase() { }
       virtual bool compare( double, double ) const = 0;
+      virtual void compare( const double * lhs, const double * rhs, bool * out, size_t n ) const {
+        for( size_t i = 0; i != n; ++i ) out[i] = compare( lhs[i], rhs[i] );
+      }
     };
   }
 }
@@ -8,16 +8,21 @@
  *         adapted by Luca Lista, INFN
  *
  */
+#include "FWCore/Utilities/interface/ObjectWithDict.h"
 #include <boost/shared_ptr.hpp>
+#include <cstddef>
 #include <vector>
 
-namespace edm { class ObjectWithDict; }
-
 namespace reco {
   namespace parser {
     struct ExpressionBase {
       virtual ~ExpressionBase() { }
       virtual double value( const edm::ObjectWithDict & ) const = 0;
+      /// evaluates the expression for all the objects at once, out must hold objs.size() values.
+      /// The nodes of the expression tree override it to work column by column
+      virtual void values( const std::vector<edm::ObjectWithDict> & objs, double * out ) const {
+        for( size_t i = 0, n = objs.size(); i != n; ++i ) out[i] = value( objs[i] );
+      }
     };
     typedef boost::shared_ptr<ExpressionBase> ExpressionPtr;
   }
@@ -20,6 +20,13 @@ namespace reco {
       double value(const edm::ObjectWithDict& o) const override { 
 	return op_((*lhs_).value(o), (*rhs_).value(o));
       }
+      void values(const std::vector<edm::ObjectWithDict>& objs, double * out) const override {
+	const size_t n = objs.size();
+	std::vector<double> rhs(n);
+	(*lhs_).values(objs, out);
+	(*rhs_).values(objs, rhs.data());
+	for(size_t i = 0; i != n; ++i) out[i] = op_(out[i], rhs[i]);
+      }
       ExpressionBinaryOperator(ExpressionStack & expStack) { 
 	rhs_ = expStack.back(); expStack.pop_back();
 	lhs_ = expStack.back(); expStack.pop_back();
@@ -14,6 +14,8 @@
 #include "CommonTools/Utils/src/SelectorBase.h"
 #include "CommonTools/Utils/src/SelectorStack.h"
 #include "CommonTools/Utils/src/ExpressionStack.h"
+#include <memory>
+#include <vector>
 
 namespace reco {
   namespace parser {
@@ -21,6 +23,21 @@ namespace reco {
       double value(const edm::ObjectWithDict& o) const override { 
 	return (*cond_)(o) ? true_->value(o) : false_->value(o);
       }
+      void values(const std::vector<edm::ObjectWithDict>& objs, double * out) const override {
+	const size_t n = objs.size();
+	std::unique_ptr<bool[]> cond(new bool[n]);
+	cond_->select(objs, cond.get());
+	// each branch is only evaluated for the objects which take it
+	for(bool branch : {true, false}) {
+	  std::vector<edm::ObjectWithDict> masked;
+	  std::vector<size_t> indices;
+	  maskedObjects(objs, cond.get(), branch, masked, indices);
+	  if(masked.empty()) continue;
+	  std::vector<double> result(masked.size());
+	  (branch ? true_ : false_)->values(masked, result.data());
+	  for(size_t i = 0; i != indices.size(); ++i) out[indices[i]] = result[i];
+	}
+      }
       ExpressionCondition(ExpressionStack & expStack, SelectorStack & selStack) { 
 	false_ = expStack.back(); expStack.pop_back();
 	true_  = expStack.back(); expStack.pop_back();
@@ -11,11 +11,15 @@
  *
  */
 #include "CommonTools/Utils/src/ExpressionBase.h"
+#include <algorithm>
 
 namespace reco {
   namespace parser {
     struct ExpressionNumber : public ExpressionBase {
       double value( const edm::ObjectWithDict& ) const override { return value_; }
+      void values( const std::vector<edm::ObjectWithDict>& objs, double * out ) const override {
+        std::fill( out, out + objs.size(), value_ );
+      }
       ExpressionNumber( double value ) : value_( value ) { }
     private:
       double value_;
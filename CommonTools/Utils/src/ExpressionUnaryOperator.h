@@ -20,6 +20,10 @@ namespace reco {
       double value(const edm::ObjectWithDict& o) const override { 
 	return op_((*exp_).value(o));
       }
+      void values(const std::vector<edm::ObjectWithDict>& objs, double * out) const override {
+	(*exp_).values(objs, out);
+	for(size_t i = 0, n = objs.size(); i != n; ++i) out[i] = op_(out[i]);
+      }
       ExpressionUnaryOperator(ExpressionStack & expStack) { 
 	exp_ = expStack.back(); expStack.pop_back();
       }
@@ -1,5 +1,7 @@
 #include "CommonTools/Utils/src/LogicalBinaryOperator.h"
 
+#include <memory>
+
 using namespace reco::parser;
 template <>
 bool LogicalBinaryOperator<std::logical_and<bool> >::operator()(const edm::ObjectWithDict &o) const {
@@ -10,3 +12,26 @@ bool LogicalBinaryOperator<std::logical_or<bool> >::operator()(const edm::Object
    return (*lhs_)(o) || (*rhs_)(o);
 }
 
+namespace {
+  // the right hand side is evaluated only for the objects whose result is not decided by the left hand side
+  void selectShortCircuit(const SelectorPtr& lhs, const SelectorPtr& rhs,
+                          const std::vector<edm::ObjectWithDict>& objs, bool * out, bool undecided) {
+    lhs->select(objs, out);
+    std::vector<edm::ObjectWithDict> masked;
+    std::vector<size_t> indices;
+    maskedObjects(objs, out, undecided, masked, indices);
+    if(masked.empty()) return;
+    std::unique_ptr<bool[]> result(new bool[masked.size()]);
+    rhs->select(masked, result.get());
+    for(size_t i = 0; i != indices.size(); ++i) out[indices[i]] = result[i];
+  }
+}
+
+template <>
+void LogicalBinaryOperator<std::logical_and<bool> >::select(const std::vector<edm::ObjectWithDict>& objs, bool * out) const {
+   selectShortCircuit(lhs_, rhs_, objs, out, true);
+}
+template <>
+void LogicalBinaryOperator<std::logical_or<bool> >::select(const std::vector<edm::ObjectWithDict>& objs, bool * out) const {
+   selectShortCircuit(lhs_, rhs_, objs, out, false);
+}
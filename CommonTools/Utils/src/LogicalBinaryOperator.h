@@ -22,6 +22,7 @@ namespace reco {
 	lhs_ = selStack.back(); selStack.pop_back();
       }
       bool operator()(const edm::ObjectWithDict& o) const override ;
+      void select(const std::vector<edm::ObjectWithDict>& objs, bool * out) const override ;
       private:
       Op op_;
       SelectorPtr lhs_, rhs_;
@@ -31,6 +32,10 @@ template <>
 bool LogicalBinaryOperator<std::logical_and<bool> >::operator()(const edm::ObjectWithDict &o) const ;
 template <>
 bool LogicalBinaryOperator<std::logical_or<bool> >::operator()(const edm::ObjectWithDict &o) const ;
+template <>
+void LogicalBinaryOperator<std::logical_and<bool> >::select(const std::vector<edm::ObjectWithDict>& objs, bool * out) const ;
+template <>
+void LogicalBinaryOperator<std::logical_or<bool> >::select(const std::vector<edm::ObjectWithDict>& objs, bool * out) const ;
   }
 }
 
@@ -23,6 +23,10 @@ namespace reco {
       bool operator()(const edm::ObjectWithDict& o) const override {
 	return op_((*rhs_)(o));
       }
+      void select(const std::vector<edm::ObjectWithDict>& objs, bool * out) const override {
+	rhs_->select(objs, out);
+	for(size_t i = 0, n = objs.size(); i != n; ++i) out[i] = op_(out[i]);
+      }
       private:
       Op op_;
       SelectorPtr rhs_;
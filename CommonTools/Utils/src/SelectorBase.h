@@ -9,8 +9,9 @@
  * \version $Revision: 1.2 $
  *
  */
-
-namespace edm {class ObjectWithDict;}
+#include "FWCore/Utilities/interface/ObjectWithDict.h"
+#include <cstddef>
+#include <vector>
 
 namespace reco {
   namespace parser {
@@ -20,7 +21,23 @@ namespace reco {
       virtual ~SelectorBase() { }
       /// return true if the object is selected
       virtual bool operator()(const edm::ObjectWithDict & c) const = 0;
+      /// selects all the objects at once, out must hold objs.size() values
+      virtual void select(const std::vector<edm::ObjectWithDict> & objs, bool * out) const {
+        for(size_t i = 0, n = objs.size(); i != n; ++i) out[i] = (*this)(objs[i]);
+      }
     };
+
+    /// the objects for which mask is equal to value, and their indices: used to evaluate the
+    /// right hand side of && and || only where the object-by-object evaluation would
+    inline void maskedObjects(const std::vector<edm::ObjectWithDict> & objs, const bool * mask, bool value,
+                              std::vector<edm::ObjectWithDict> & masked, std::vector<size_t> & indices) {
+      for(size_t i = 0, n = objs.size(); i != n; ++i) {
+        if(mask[i] == value) {
+          masked.push_back(objs[i]);
+          indices.push_back(i);
+        }
+      }
+    }
   }
 }
 
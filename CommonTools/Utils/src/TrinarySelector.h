@@ -29,6 +29,21 @@ namespace reco {
 	  cmp1_->compare( lhs_->value( o ), mid_->value( o ) ) &&
 	  cmp2_->compare( mid_->value( o ), rhs_->value( o ) );
       }
+      void select( const std::vector<edm::ObjectWithDict>& objs, bool * out ) const override {
+	const size_t n = objs.size();
+	std::vector<double> lhs( n ), mid( n );
+	lhs_->values( objs, lhs.data() );
+	mid_->values( objs, mid.data() );
+	cmp1_->compare( lhs.data(), mid.data(), out, n );
+	// the upper bound is only evaluated where the lower one passed
+	std::vector<edm::ObjectWithDict> passed;
+	std::vector<size_t> indices;
+	maskedObjects( objs, out, true, passed, indices );
+	if( passed.empty() ) return;
+	std::vector<double> rhs( passed.size() );
+	rhs_->values( passed, rhs.data() );
+	for( size_t i = 0; i != indices.size(); ++i ) out[indices[i]] = cmp2_->compare( mid[indices[i]], rhs[i] );
+      }
       boost::shared_ptr<ExpressionBase> lhs_;
       boost::shared_ptr<ComparisonBase> cmp1_;
       boost::shared_ptr<ExpressionBase> mid_;
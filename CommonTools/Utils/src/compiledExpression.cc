@@ -0,0 +1,214 @@
+#include "CommonTools/Utils/interface/compiledExpression.h"
+#include "FWCore/MessageLogger/interface/MessageLogger.h"
+#include "FWCore/Utilities/interface/Exception.h"
+
+#include <cctype>
+#include <map>
+#include <mutex>
+#include <vector>
+
+namespace {
+  // functions of the grammar with the same meaning in <cmath>; the others (atan2, log10, chi2prob,
+  // deltaR, deltaPhi, test_bit) are left to the reflection based evaluation
+  const std::map<std::string, std::string>& functions() {
+    static const std::map<std::string, std::string> s_functions = {
+      {"abs", "std::abs"}, {"acos", "std::acos"}, {"asin", "std::asin"}, {"atan", "std::atan"},
+      {"cos", "std::cos"}, {"cosh", "std::cosh"}, {"exp", "std::exp"}, {"hypot", "std::hypot"},
+      {"log", "std::log"}, {"max", "std::max<double>"}, {"min", "std::min<double>"}, {"pow", "std::pow"},
+      {"sin", "std::sin"}, {"sinh", "std::sinh"}, {"sqrt", "std::sqrt"}, {"tan", "std::tan"},
+      {"tanh", "std::tanh"}
+    };
+    return s_functions;
+  }
+
+  bool isIdentifierChar(char c) { return std::isalnum(c) || c == '_'; }
+
+  void skipBlanks(const std::string& s, size_t& i) {
+    while (i < s.size() && std::isspace(s[i])) ++i;
+  }
+
+  std::string readIdentifier(const std::string& s, size_t& i) {
+    size_t begin = i;
+    while (i < s.size() && isIdentifierChar(s[i])) ++i;
+    return s.substr(begin, i - begin);
+  }
+
+  // method arguments are literals: numbers are copied as they are, so that integers stay integers,
+  // strings are requoted with '"'
+  bool copyArguments(const std::string& s, size_t& i, char close, bool allowSeveral, std::string& out) {
+    ++i;
+    while (i < s.size() && s[i] != close) {
+      char c = s[i];
+      if (std::isspace(c)) {
+        ++i;
+      } else if (c == '"' || c == '\'') {
+        size_t end = s.find(c, i + 1);
+        if (end == std::string::npos) return false;
+        out += '"';
+        for (size_t j = i + 1; j != end; ++j) {
+          if (s[j] == '"' || s[j] == '\\') out += '\\';
+          out += s[j];
+        }
+        out += '"';
+        i = end + 1;
+      } else if (std::isdigit(c) || c == '.' || c == '-' || c == '+' || c == 'e' || c == 'E') {
+        out += c;
+        ++i;
+      } else if (c == ',' && allowSeveral) {
+        out += ", ";
+        ++i;
+      } else {
+        return false;
+      }
+    }
+    if (i == s.size()) return false;
+    ++i;
+    return true;
+  }
+}
+
+namespace reco {
+  namespace parser {
+
+    bool expressionToCpp(const std::string& expr, std::string& cpp) {
+      struct Level {
+        // number of comparisons since the last logical operator: "a < b < c" means "a < b && b < c"
+        // in the grammar but not in C++
+        int comparisons = 0;
+        // '!' applies to the whole comparison in the grammar, "!a > b" is "!(a > b)"
+        int nots = 0;
+      };
+      auto closeNots = [](Level& level, std::string& out) {
+        for (; level.nots > 0; --level.nots) out += ") ";
+      };
+      std::string out;
+      std::vector<Level> levels(1);
+      size_t i = 0;
+      const std::string& s = expr;
+      while (i < s.size()) {
+        char c = s[i];
+        char next = i + 1 < s.size() ? s[i + 1] : '\0';
+        if (std::isspace(c)) {
+          ++i;
+        } else if (std::isdigit(c) || (c == '.' && std::isdigit(next))) {
+          // all the values are double in the grammar, 3/2 is 1.5
+          bool isInteger = true;
+          while (i < s.size() && (std::isdigit(s[i]) || s[i] == '.' || s[i] == 'e' || s[i] == 'E' ||
+                                  ((s[i] == '-' || s[i] == '+') && (s[i - 1] == 'e' || s[i - 1] == 'E')))) {
+            if (!std::isdigit(s[i])) isInteger = false;
+            out += s[i++];
+          }
+          if (isInteger) out += ".";
+          out += ' ';
+        } else if (std::isalpha(c)) {
+          std::string name = readIdentifier(s, i);
+          size_t j = i;
+          skipBlanks(s, j);
+          auto function = functions().find(name);
+          if (function != functions().end() && j < s.size() && s[j] == '(') {
+            out += function->second;
+            continue;
+          }
+          // a chain of methods: every value is converted to double, as in the reflection based evaluation
+          out += "static_cast<double>(o.";
+          for (;;) {
+            out += name;
+            out += "(";
+            if (j < s.size() && s[j] == '(') {
+              i = j;
+              if (!copyArguments(s, i, ')', true, out)) return false;
+            }
+            out += ")";
+            j = i;
+            skipBlanks(s, j);
+            while (j < s.size() && s[j] == '[') {
+              i = j;
+              out += "[";
+              // a comma inside [] would be the comma operator in C++
+              if (!copyArguments(s, i, ']', false, out)) return false;
+              out += "]";
+              j = i;
+              skipBlanks(s, j);
+            }
+            if (j < s.size() && s[j] == '.') {
+              i = j + 1;
+              skipBlanks(s, i);
+              if (i == s.size() || !std::isalpha(s[i])) return false;
+              out += ".";
+              name = readIdentifier(s, i);
+              j = i;
+              skipBlanks(s, j);
+              continue;
+            }
+            break;
+          }
+          out += ") ";
+        } else if ((c == '&' || c == '|')) {
+          i += (next == c) ? 2 : 1;
+          closeNots(levels.back(), out);
+          out += (c == '&') ? "&& " : "|| ";
+          levels.back().comparisons = 0;
+        } else if (c == '<' || c == '>' || c == '=' || (c == '!' && next == '=')) {
+          if (++levels.back().comparisons > 1) return false;
+          out += (c == '=') ? '=' : c;
+          out += (next == '=' || c == '=') ? "= " : " ";
+          i += (next == '=') ? 2 : 1;
+        } else if (c == '!') {
+          out += "!( ";
+          ++levels.back().nots;
+          ++i;
+        } else if (c == '(') {
+          levels.emplace_back();
+          out += "( ";
+          ++i;
+        } else if (c == ')') {
+          if (levels.size() == 1) return false;
+          closeNots(levels.back(), out);
+          levels.pop_back();
+          out += ") ";
+          ++i;
+        } else if (c == ',') {
+          if (levels.back().nots > 0) return false;
+          levels.back().comparisons = 0;
+          out += ", ";
+          ++i;
+        } else if (c == '+' || c == '-' || c == '*' || c == '/') {
+          out += c;
+          out += ' ';
+          ++i;
+        } else {
+          // '^' is a power and '?' starts a condition in the grammar
+          return false;
+        }
+      }
+      if (out.empty() || levels.size() != 1) return false;
+      closeNots(levels.back(), out);
+      cpp = out;
+      return true;
+    }
+
+    void const* compiledExpression(const std::string& pkg, const std::string& base, const std::string& body,
+                                   CompiledExpressionGetter getter) {
+      static std::mutex s_mutex;
+      static std::map<std::string, void const*> s_compiled;
+
+      const std::string key = pkg + '\n' + base + '\n' + body;
+      std::lock_guard<std::mutex> guard(s_mutex);
+      auto found = s_compiled.find(key);
+      if (found != s_compiled.end()) return found->second;
+
+      void const* compiled = nullptr;
+      try {
+        ExpressionEvaluator ee(pkg.c_str(), base.c_str(), body);
+        compiled = getter(ee);
+      } catch (cms::Exception const& e) {
+        edm::LogInfo("StringExpressionCompilation")
+            << "using the reflection based evaluation for\n" << body << "\n" << e.what();
+      }
+      // failures are cached as well, not to run the compiler again for the same expression
+      s_compiled.emplace(key, compiled);
+      return compiled;
+    }
+
+  }
+}
@@ -0,0 +1,66 @@
+// compares the reflection based and the compiled evaluation of StringCutObjectSelector and StringObjectFunction
+#include "CommonTools/Utils/interface/StringCutObjectSelector.h"
+#include "CommonTools/Utils/interface/StringObjectFunction.h"
+#include "DataFormats/Candidate/interface/LeafCandidate.h"
+
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <vector>
+
+namespace {
+  std::vector<reco::LeafCandidate> generate(unsigned int n) {
+    std::vector<reco::LeafCandidate> ret;
+    ret.reserve(n);
+    for (unsigned int i = 0; i < n; ++i) {
+      double pt = 5. + (i % 97);
+      double eta = -3. + 0.06 * (i % 101);
+      double phi = -3. + 0.06 * (i % 103);
+      ret.emplace_back(i % 2 ? 1 : -1, reco::LeafCandidate::PolarLorentzVector(pt, eta, phi, 0.1));
+    }
+    return ret;
+  }
+
+  template <typename F>
+  double time(F f, unsigned int nLoops) {
+    auto start = std::chrono::steady_clock::now();
+    for (unsigned int i = 0; i < nLoops; ++i) f();
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count() / nLoops;
+  }
+}
+
+int main() {
+  auto const cands = generate(100000);
+  constexpr unsigned int kLoops = 10;
+  const std::string pkg = "CommonTools/CandUtils";
+  int ret = 0;
+
+  for (auto const& cut : {"pt > 20 && abs(eta) < 2.4", "charge > 0 & (et > 30 | abs(rapidity) < 1)"}) {
+    StringCutObjectSelector<reco::LeafCandidate> reflection(cut);
+    StringCutObjectSelector<reco::LeafCandidate> compiled(cut, false, pkg);
+    unsigned int nReflection = 0, nCompiled = 0;
+    double tReflection = time([&]() { nReflection = 0; for (auto const& c : cands) nReflection += reflection(c); }, kLoops);
+    double tCompiled = time([&]() { nCompiled = 0; for (auto const& c : cands) nCompiled += compiled(c); }, kLoops);
+    std::cout << "cut \"" << cut << "\": reflection " << tReflection << " ms, compiled " << tCompiled << " ms for "
+              << cands.size() << " candidates" << std::endl;
+    if (nReflection != nCompiled) {
+      std::cout << "  different selections: " << nReflection << " and " << nCompiled << std::endl;
+      ret = 1;
+    }
+  }
+
+  for (auto const& expr : {"pt*cosh(eta)", "sqrt(px*px + py*py) / 2"}) {
+    StringObjectFunction<reco::LeafCandidate> reflection(expr);
+    StringObjectFunction<reco::LeafCandidate> compiled(expr, false, pkg);
+    double sReflection = 0., sCompiled = 0.;
+    double tReflection = time([&]() { sReflection = 0.; for (auto const& c : cands) sReflection += reflection(c); }, kLoops);
+    double tCompiled = time([&]() { sCompiled = 0.; for (auto const& c : cands) sCompiled += compiled(c); }, kLoops);
+    std::cout << "expression \"" << expr << "\": reflection " << tReflection << " ms, compiled " << tCompiled
+              << " ms for " << cands.size() << " candidates" << std::endl;
+    if (std::abs(sReflection - sCompiled) > 1.e-6 * std::abs(sReflection)) {
+      std::cout << "  different sums: " << sReflection << " and " << sCompiled << std::endl;
+      ret = 1;
+    }
+  }
+  return ret;
+}
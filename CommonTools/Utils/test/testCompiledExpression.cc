@@ -0,0 +1,58 @@
+#include <cppunit/extensions/HelperMacros.h>
+#include "CommonTools/Utils/interface/compiledExpression.h"
+#include <string>
+
+class testCompiledExpression : public CppUnit::TestFixture {
+  CPPUNIT_TEST_SUITE(testCompiledExpression);
+  CPPUNIT_TEST(checkTranslation);
+  CPPUNIT_TEST(checkNoTranslation);
+  CPPUNIT_TEST_SUITE_END();
+
+public:
+  void setUp() {}
+  void tearDown() {}
+  void checkTranslation();
+  void checkNoTranslation();
+  std::string translate(const std::string &);
+};
+
+CPPUNIT_TEST_SUITE_REGISTRATION(testCompiledExpression);
+
+std::string testCompiledExpression::translate(const std::string & expr) {
+  std::string cpp;
+  CPPUNIT_ASSERT(reco::parser::expressionToCpp(expr, cpp));
+  return cpp;
+}
+
+void testCompiledExpression::checkTranslation() {
+  CPPUNIT_ASSERT(translate("pt > 20 && abs(eta) < 2.4") ==
+                 "static_cast<double>(o.pt()) > 20. && std::abs( static_cast<double>(o.eta()) ) < 2.4 ");
+  // single character operators of the grammar
+  CPPUNIT_ASSERT(translate("pt>3 & eta=1 | phi<2") ==
+                 "static_cast<double>(o.pt()) > 3. && static_cast<double>(o.eta()) == 1. || static_cast<double>(o.phi()) < 2. ");
+  // every value is a double
+  CPPUNIT_ASSERT(translate("charge/2") == "static_cast<double>(o.charge()) / 2. ");
+  // method chains and literal arguments
+  CPPUNIT_ASSERT(translate("track().hitPattern.numberOfValidHits >= 10") ==
+                 "static_cast<double>(o.track().hitPattern().numberOfValidHits()) >= 10. ");
+  CPPUNIT_ASSERT(translate("userFloat('iso') < 0.1*pt") ==
+                 "static_cast<double>(o.userFloat(\"iso\")) < 0.1 * static_cast<double>(o.pt()) ");
+  CPPUNIT_ASSERT(translate("daughter(1).pt") == "static_cast<double>(o.daughter(1).pt()) ");
+  // '!' applies to the whole comparison
+  CPPUNIT_ASSERT(translate("!pt > 3 && isGlobalMuon") ==
+                 "!( static_cast<double>(o.pt()) > 3. ) && static_cast<double>(o.isGlobalMuon()) ");
+  CPPUNIT_ASSERT(translate("max(pt, 2.5e-3)") == "std::max<double>( static_cast<double>(o.pt()) , 2.5e-3 ) ");
+}
+
+void testCompiledExpression::checkNoTranslation() {
+  std::string cpp;
+  // no C++ equivalent
+  CPPUNIT_ASSERT(!reco::parser::expressionToCpp("", cpp));
+  CPPUNIT_ASSERT(!reco::parser::expressionToCpp("5 < pt < 10", cpp));
+  CPPUNIT_ASSERT(!reco::parser::expressionToCpp("pt^2", cpp));
+  CPPUNIT_ASSERT(!reco::parser::expressionToCpp("? pt > 3 ? 1 : 2", cpp));
+  CPPUNIT_ASSERT(!reco::parser::expressionToCpp("deltaR(eta, phi, 0, 0) < 0.4", cpp));
+  CPPUNIT_ASSERT(!reco::parser::expressionToCpp("covariance[1,2] > 0", cpp));
+  CPPUNIT_ASSERT(!reco::parser::expressionToCpp("userFloat(pt) > 0", cpp));
+  CPPUNIT_ASSERT(cpp.empty());
+}
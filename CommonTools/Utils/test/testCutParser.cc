@@ -45,9 +45,11 @@ public:
   void tearDown() {}
   void checkAll(); 
   void check(const std::string &, bool);
+  void checkColumns(const std::string &);
   void checkHit(const std::string &, bool, const SiStripRecHit2D &);
   void checkMuon(const std::string &, bool, const reco::Muon &);
   reco::Track trk;
+  std::vector<reco::Track> others; // tracks for which the cuts give different results than for trk
   SiStripRecHit2D hitOk, hitThrow;
   edm::ObjectWithDict o;
   reco::parser::SelectorPtr sel;
@@ -63,6 +65,39 @@ void testCutParser::check(const std::string & cut, bool res) {
   CPPUNIT_ASSERT((*sel)(o) == res);
   StringCutObjectSelector<reco::Track> select(cut, lazy);
   CPPUNIT_ASSERT(select(trk) == res);
+  // column evaluation, over trk and tracks for which the cut may give another result
+  std::vector<const reco::Track *> trks(1, &trk);
+  for (const reco::Track & other : others) {
+    trks.push_back(&other);
+    trks.push_back(&trk);
+  }
+  std::vector<bool> selected;
+  select.evaluate(trks, selected);
+  CPPUNIT_ASSERT(selected.size() == trks.size());
+  for (size_t i = 0; i != trks.size(); ++i) CPPUNIT_ASSERT(selected[i] == select(*trks[i]));
+  CPPUNIT_ASSERT(selected[0] == res);
+  }
+}
+
+// the column evaluation of a cut which selects some of the tracks but not all
+void testCutParser::checkColumns(const std::string & cut) {
+  for (int lazy = 0; lazy <= 1; ++lazy) {
+  std::cerr << "evaluating " << (lazy ? "lazy " : "") << "cut: \"" << cut << "\" on columns" << std::endl;
+  StringCutObjectSelector<reco::Track> select(cut, lazy);
+  std::vector<const reco::Track *> trks;
+  for (const reco::Track & other : others) {
+    trks.push_back(&trk);
+    trks.push_back(&other);
+  }
+  std::vector<bool> selected;
+  select.evaluate(trks, selected);
+  CPPUNIT_ASSERT(selected.size() == trks.size());
+  size_t nSelected = 0;
+  for (size_t i = 0; i != trks.size(); ++i) {
+    CPPUNIT_ASSERT(selected[i] == select(*trks[i]));
+    if (selected[i]) ++nSelected;
+  }
+  CPPUNIT_ASSERT(nSelected > 0 && nSelected < trks.size());
   }
 }
 
@@ -108,6 +143,12 @@ void testCutParser::checkAll() {
   reco::TrackBase::CovarianceMatrix cov(e, e + 15);
   trk = reco::Track(chi2, ndof, v, p, -1, cov);
   trk.setQuality(reco::Track::highPurity);
+  // pt = 1, 5, 1.5 and 3, with phi = pi/2 but for the third one
+  others.clear();
+  others.push_back(reco::Track(chi2, ndof, v, reco::Track::Vector(0, 1, 10), +1, cov));
+  others.push_back(reco::Track(chi2, ndof, v, reco::Track::Vector(0, 5, 10), -1, cov));
+  others.push_back(reco::Track(chi2, ndof, v, reco::Track::Vector(1.5, 0, 10), -1, cov));
+  others.push_back(reco::Track(chi2, ndof, v, reco::Track::Vector(0, 3, 10), +1, cov));
 
   GlobalPoint gp(0,0,0);
   BoundPlane* plane = new BoundPlane( gp, Surface::RotationType());
@@ -171,6 +212,17 @@ void testCutParser::checkAll() {
   // check trailing space
   check( "pt > 2 ", true );
 
+  // check the column evaluation where the short circuits of && and || and the upper bound
+  // of a trinary comparison are taken for some objects only
+  checkColumns( "pt > 2 && charge < 0" );
+  checkColumns( "pt > 2 & charge < 0 & 0.99 < sin( phi ) < 1.01" );
+  checkColumns( "pt < 2 || charge > 0" );
+  checkColumns( "pt > 4 | charge > 0 | (pt < 2 && charge < 0)" );
+  checkColumns( "! (pt > 2 && charge < 0)" );
+  checkColumns( "2.9 < pt < 3.1" );
+  checkColumns( "1.2 < pt < 4" );
+  checkColumns( "( 1.2 < pt < 4 ) || charge < 0" );
+
   // check bit tests
   check( "test_bit(7, 0)", true  );
   check( "test_bit(7, 2)", true  );
@@ -259,4 +311,14 @@ void testCutParser::checkAll() {
   checkHit( "!hasPositionAndError || (localPosition.x = 1)", true,  hitOk    );
   checkHit( "!hasPositionAndError || (localPosition.x = 1)", true, hitThrow );
 
+  // and in the column evaluation, where the right hand side is only evaluated for hitOk
+  std::vector<const SiStripRecHit2D *> hits = { &hitOk, &hitThrow, &hitThrow, &hitOk };
+  for (int lazy = 0; lazy <= 1; ++lazy) {
+    std::vector<bool> selected;
+    StringCutObjectSelector<SiStripRecHit2D>("hasPositionAndError && (localPosition.x = 1)", lazy).evaluate(hits, selected);
+    CPPUNIT_ASSERT(selected == std::vector<bool>({ true, false, false, true }));
+    StringCutObjectSelector<SiStripRecHit2D>("!hasPositionAndError || (localPosition.x = 1)", lazy).evaluate(hits, selected);
+    CPPUNIT_ASSERT(selected == std::vector<bool>(4, true));
+  }
+
 }
@@ -31,6 +31,7 @@ public:
   void checkJet(const std::string &, double);
   void checkMuon(const std::string &, double);
   reco::Track trk;
+  std::vector<reco::Track> others; // tracks for which the expressions take other values than for trk
   reco::CompositeCandidate cand;
   edm::ObjectWithDict o;
   reco::parser::ExpressionPtr expr;
@@ -50,6 +51,17 @@ void testExpressionParser::checkTrack(const std::string & expression, double x)
   StringObjectFunction<reco::Track> f(expression, lazyMode);
   CPPUNIT_ASSERT(fabs(f(trk) - res) < 1.e-6);
   CPPUNIT_ASSERT(fabs(f(trk) - x) < 1.e-6);
+  // column evaluation, over trk and tracks for which the expression may take other values
+  std::vector<const reco::Track *> trks(1, &trk);
+  for (const reco::Track & other : others) {
+    trks.push_back(&other);
+    trks.push_back(&trk);
+  }
+  std::vector<double> values;
+  f.evaluate(trks, values);
+  CPPUNIT_ASSERT(values.size() == trks.size());
+  for (size_t i = 0; i != trks.size(); ++i) CPPUNIT_ASSERT(fabs(values[i] - f(*trks[i])) < 1.e-6);
+  CPPUNIT_ASSERT(fabs(values[0] - res) < 1.e-6);
   std::cerr << " = " << res << std::endl;
   }
 }
@@ -139,6 +151,13 @@ void testExpressionParser::checkAll() {
   reco::TrackExtraRef trkExtraRef(h, 0);
   trk.setExtra(trkExtraRef);
   trk.setAlgorithm(reco::Track::pixelPairStep);
+  // ndof = 10, 9 and 8, alternating charges
+  others.clear();
+  for (int i = 1; i <= 3; ++i) {
+    others.push_back(reco::Track(chi2 * i, ndof + 1 - i, v, reco::Track::Vector(5 - 2 * i, 3 * i, 10), i % 2 ? 1 : -1, cov));
+    others.back().setExtra(trkExtraRef);
+    others.back().setAlgorithm(reco::Track::pixelPairStep);
+  }
   {
     edm::TypeWithDict t(typeid(reco::Track));
     o = edm::ObjectWithDict(t, & trk);
@@ -158,6 +177,12 @@ void testExpressionParser::checkAll() {
     checkTrack("hypot(px, py)", hypot(trk.px(), trk.py()));
     checkTrack("?ndof<0?1:0", trk.ndof()<0?1:0);
     checkTrack("?ndof=10?1:0", trk.ndof()==10?1:0);
+    // conditions which differ between the tracks of the column evaluation, with && and || and
+    // trinary comparisons evaluated on the tracks left undecided
+    checkTrack("?charge>0?pt:-pt", trk.charge()>0?trk.pt():-trk.pt());
+    checkTrack("?ndof=10 && charge<0?chi2:ndof", trk.ndof()==10&&trk.charge()<0?trk.chi2():trk.ndof());
+    checkTrack("?ndof<9 || charge>0?px:py", trk.ndof()<9||trk.charge()>0?trk.px():trk.py());
+    checkTrack("?8.5<ndof<9.5?1:(?pt>5?2:3)", 8.5<trk.ndof()&&trk.ndof()<9.5?1:(trk.pt()>5?2:3));
   }
   reco::Candidate::LorentzVector p1(1, 2, 3, 4);
   reco::Candidate::LorentzVector p2(1.1, -2.5, 4.3, 13.7);
@@ -21,6 +21,12 @@ namespace cond {
   class CoralServiceManager;
 }
 
+namespace cond {
+  namespace persistency {
+    class PayloadCache;
+  }
+}
+
 namespace cond {
 
   namespace persistency {
@@ -38,6 +44,8 @@ namespace cond {
       void setAuthenticationSystem( int authSysCode );
       void setFrontierSecurity( const std::string& signature );
       void setLogging( bool flag );   
+      // keep a local copy of the fetched payloads in the given directory; an empty path disables the cache
+      void setPayloadCache( const std::string& directory, size_t maxSizeMB = 0 );
       bool isLoggingEnabled() const;
       void setParameters( const edm::ParameterSet& connectionPset );
       void configure();
@@ -64,6 +72,9 @@ namespace cond {
       // this one has to be moved!
       cond::CoralServiceManager* m_pluginManager = nullptr; 
       std::map<std::string,int> m_dbTypes;
+      std::string m_payloadCachePath = std::string( "" );
+      size_t m_payloadCacheMaxSizeMB = 0;
+      std::shared_ptr<PayloadCache> m_payloadCache;
     };
   }
 }
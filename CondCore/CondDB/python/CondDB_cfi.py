@@ -6,6 +6,10 @@ CondDB = cms.PSet(
         authenticationSystem = cms.untracked.int32(0),
         security = cms.untracked.string(''),
         messageLevel = cms.untracked.int32(0),
+        # local directory caching the fetched payloads, shared by the jobs on the node; empty to disable
+        payloadCachePath = cms.untracked.string(''),
+        # size limit of the payload cache, least recently used payloads are removed first; 0 for no limit
+        payloadCacheMaxSizeMB = cms.untracked.uint32(0),
     ),
     connect = cms.string(''), 
 )
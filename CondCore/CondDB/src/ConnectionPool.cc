@@ -2,6 +2,7 @@
 #include "DbConnectionString.h"
 #include "SessionImpl.h"
 #include "IOVSchema.h"
+#include "PayloadCache.h"
 //
 #include "CondCore/CondDB/interface/CoralServiceManager.h"
 #include "CondCore/CondDB/interface/Auth.h"
@@ -74,6 +75,18 @@ namespace cond {
       }
       setMessageVerbosity( level );
       setLogging( connectionPset.getUntrackedParameter<bool>( "logging", m_loggingEnabled ) );
+      setPayloadCache( connectionPset.getUntrackedParameter<std::string>( "payloadCachePath", m_payloadCachePath ),
+                       connectionPset.getUntrackedParameter<unsigned int>( "payloadCacheMaxSizeMB", m_payloadCacheMaxSizeMB ) );
+    }
+
+    void ConnectionPool::setPayloadCache( const std::string& directory, size_t maxSizeMB ){
+      m_payloadCachePath = directory;
+      m_payloadCacheMaxSizeMB = maxSizeMB;
+      if( directory.empty() ){
+        m_payloadCache.reset();
+      } else {
+        m_payloadCache = std::make_shared<PayloadCache>( directory, maxSizeMB*1024*1024 );
+      }
     }
 
     bool ConnectionPool::isLoggingEnabled() const {
@@ -156,7 +169,10 @@ namespace cond {
                                            const std::string& transactionId, 
                                            bool writeCapable ){
       std::shared_ptr<coral::ISessionProxy> coralSession = createCoralSession( connectionString, transactionId, writeCapable );
-      return Session( std::make_shared<SessionImpl>( coralSession, connectionString ));
+      auto session = std::make_shared<SessionImpl>( coralSession, connectionString );
+      // payloads written by this session must not be picked up from (nor pushed into) the local cache
+      if( !writeCapable ) session->payloadCache = m_payloadCache;
+      return Session( session );
     }
 
     Session ConnectionPool::createSession( const std::string& connectionString, bool writeCapable ){
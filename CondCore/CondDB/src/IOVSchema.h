@@ -10,6 +10,9 @@ namespace cond {
 
   namespace persistency {
 
+    // the identifier of a payload: sha1 of its type name and of its serialized data
+    cond::Hash makeHash( const std::string& objectType, const cond::Binary& data );
+
     conddb_table( TAG ) {
       
       conddb_column( NAME, std::string );
@@ -0,0 +1,180 @@
+#include "PayloadCache.h"
+#include "IOVSchema.h"
+//
+#include <boost/filesystem.hpp>
+//
+#include <algorithm>
+#include <cctype>
+#include <cstdint>
+#include <cstring>
+#include <ctime>
+#include <fstream>
+#include <vector>
+
+namespace cond {
+
+  namespace persistency {
+
+    namespace {
+      const char s_magic[8] = { 'C', 'O', 'N', 'D', 'P', 'L', 'C', '1' };
+      const std::string s_tmpTag( ".tmp." );
+
+      // the hash is used as file name: only accept what makeHash can produce
+      bool isValidHash( const cond::Hash& payloadHash ){
+        return payloadHash.size() > 2 &&
+          std::all_of( payloadHash.begin(), payloadHash.end(), []( char c ){ return std::isxdigit( c ); } );
+      }
+
+      bool readBlock( std::ifstream& in, uint64_t size, uint64_t& available, std::vector<char>& buffer ){
+        if( size > available ) return false;
+        available -= size;
+        buffer.resize( size );
+        return size == 0 || static_cast<bool>( in.read( buffer.data(), size ) );
+      }
+
+      bool readEntry( std::ifstream& in, uint64_t available, std::string& type, cond::Binary& data, cond::Binary& streamerInfo ){
+        char magic[sizeof(s_magic)];
+        if( available < sizeof(s_magic) || !in.read( magic, sizeof(magic) ) || ::memcmp( magic, s_magic, sizeof(magic) ) != 0 ) return false;
+        available -= sizeof(s_magic);
+
+        std::vector<char> buffer;
+        uint64_t size = 0;
+        for( unsigned int i = 0; i < 3; ++i ){
+          if( available < sizeof(size) || !in.read( reinterpret_cast<char*>( &size ), sizeof(size) ) ) return false;
+          available -= sizeof(size);
+          if( !readBlock( in, size, available, buffer ) ) return false;
+          switch( i ){
+          case 0:
+            type.assign( buffer.data(), buffer.size() );
+            break;
+          case 1:
+            data = cond::Binary( buffer.data(), buffer.size() );
+            break;
+          default:
+            streamerInfo = cond::Binary( buffer.data(), buffer.size() );
+          }
+        }
+        return true;
+      }
+
+      void writeBlock( std::ofstream& out, const void* data, uint64_t size ){
+        out.write( reinterpret_cast<const char*>( &size ), sizeof(size) );
+        if( size ) out.write( static_cast<const char*>( data ), size );
+      }
+    }
+
+    PayloadCache::PayloadCache( const std::string& directory, size_t maxSize ):
+      m_directory( directory ),
+      m_maxSize( maxSize ){
+    }
+
+    std::string PayloadCache::fileName( const cond::Hash& payloadHash ) const {
+      return m_directory + "/" + payloadHash.substr( 0, 2 ) + "/" + payloadHash;
+    }
+
+    bool PayloadCache::load( const cond::Hash& payloadHash,
+                             std::string& payloadType,
+                             cond::Binary& payloadData,
+                             cond::Binary& streamerInfoData ) const {
+      if( !isValidHash( payloadHash ) ) return false;
+      boost::filesystem::path file( fileName( payloadHash ) );
+      boost::system::error_code ec;
+      uint64_t available = boost::filesystem::file_size( file, ec );
+      if( ec ) return false;
+      std::ifstream in( file.string(), std::ios::binary );
+      if( !in ) return false;
+
+      std::string type;
+      cond::Binary data;
+      cond::Binary streamerInfo;
+      if( !readEntry( in, available, type, data, streamerInfo ) || makeHash( type, data ) != payloadHash ){
+        // entries are renamed into place only once complete, so this one is corrupted: drop it,
+        // it will be replaced by the next store
+        boost::filesystem::remove( file, ec );
+        return false;
+      }
+      // the modification time is used as last access time by the eviction
+      boost::filesystem::last_write_time( file, std::time( nullptr ), ec );
+
+      payloadType = type;
+      payloadData = data;
+      streamerInfoData = streamerInfo;
+      return true;
+    }
+
+    void PayloadCache::store( const cond::Hash& payloadHash,
+                              const std::string& payloadType,
+                              const cond::Binary& payloadData,
+                              const cond::Binary& streamerInfoData ) const {
+      if( !isValidHash( payloadHash ) ) return;
+      boost::filesystem::path file( fileName( payloadHash ) );
+      boost::system::error_code ec;
+      if( boost::filesystem::exists( file, ec ) ) return;
+      boost::filesystem::create_directories( file.parent_path(), ec );
+      if( ec ) return;
+
+      boost::filesystem::path tmp = boost::filesystem::unique_path( file.string() + s_tmpTag + "%%%%-%%%%-%%%%-%%%%", ec );
+      if( ec ) return;
+      {
+        std::ofstream out( tmp.string(), std::ios::binary );
+        if( out ){
+          out.write( s_magic, sizeof(s_magic) );
+          writeBlock( out, payloadType.data(), payloadType.size() );
+          writeBlock( out, payloadData.data(), payloadData.size() );
+          writeBlock( out, streamerInfoData.data(), streamerInfoData.size() );
+        }
+        out.close();
+        if( !out ){
+          boost::filesystem::remove( tmp, ec );
+          return;
+        }
+      }
+      boost::filesystem::rename( tmp, file, ec );
+      if( ec ){
+        boost::filesystem::remove( tmp, ec );
+        return;
+      }
+      if( m_maxSize ) evict( file.string() );
+    }
+
+    void PayloadCache::evict( const std::string& keep ) const {
+      struct Entry {
+        boost::filesystem::path file;
+        std::time_t lastUsed;
+        uint64_t size;
+      };
+      std::vector<Entry> entries;
+      boost::system::error_code ec;
+      // the file names are the payload hashes, unique in the cache: comparing them is not affected by how
+      // the cache directory is spelled ("dir/", "./dir"...), unlike comparing the full paths
+      const boost::filesystem::path keepName = boost::filesystem::path( keep ).filename();
+      uint64_t total = boost::filesystem::file_size( keep, ec );
+      if( ec ) total = 0;
+      boost::filesystem::recursive_directory_iterator it( m_directory, ec ), end;
+      for( ; !ec && it != end; it.increment( ec ) ){
+        const boost::filesystem::path& file = it->path();
+        // entries being written by other processes are not counted, nor removed
+        if( file.filename().string().find( s_tmpTag ) != std::string::npos ) continue;
+        // the entry just stored has the same time stamp as those written in the same second: never drop it
+        if( file.filename() == keepName ) continue;
+        boost::system::error_code fileEc;
+        if( !boost::filesystem::is_regular_file( file, fileEc ) ) continue;
+        uint64_t size = boost::filesystem::file_size( file, fileEc );
+        std::time_t lastUsed = boost::filesystem::last_write_time( file, fileEc );
+        if( fileEc ) continue;
+        entries.push_back( Entry{ file, lastUsed, size } );
+        total += size;
+      }
+      if( total <= m_maxSize ) return;
+      std::sort( entries.begin(), entries.end(), []( const Entry& a, const Entry& b ){ return a.lastUsed < b.lastUsed; } );
+      for( const auto& entry : entries ){
+        if( total <= m_maxSize ) break;
+        // a file removed while another process is reading it stays readable for that process
+        boost::filesystem::remove( entry.file, ec );
+        total -= entry.size;
+      }
+    }
+
+  }
+
+}
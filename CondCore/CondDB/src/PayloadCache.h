@@ -0,0 +1,51 @@
+#ifndef CondCore_CondDB_PayloadCache_h
+#define CondCore_CondDB_PayloadCache_h
+
+#include "CondCore/CondDB/interface/Binary.h"
+#include "CondCore/CondDB/interface/Types.h"
+//
+#include <string>
+
+namespace cond {
+
+  namespace persistency {
+
+    // A local, content-addressed store of the payload blobs fetched from the database.
+    // Every payload is kept in its own file <directory>/<hash[0,2)>/<hash>, holding the object type, the
+    // payload data and the streamer info. Files are written under a unique temporary name and renamed into place,
+    // so several processes can share the same directory: a reader either finds a complete file or none.
+    // Entries are checked against their hash when loaded, and a broken file is treated as a miss.
+    // When a maximum size is given, the least recently used entries are removed after each insertion.
+    // Failures to read or write the cache are never fatal: the payload is then simply taken from the database.
+    class PayloadCache {
+    public:
+      // maxSize in bytes, 0 means no limit
+      PayloadCache( const std::string& directory, size_t maxSize );
+
+      bool load( const cond::Hash& payloadHash,
+                 std::string& payloadType,
+                 cond::Binary& payloadData,
+                 cond::Binary& streamerInfoData ) const;
+
+      void store( const cond::Hash& payloadHash,
+                  const std::string& payloadType,
+                  const cond::Binary& payloadData,
+                  const cond::Binary& streamerInfoData ) const;
+
+      const std::string& directory() const { return m_directory; }
+
+    private:
+      std::string fileName( const cond::Hash& payloadHash ) const;
+      // removes the least recently used entries, except keep, until the size limit is met
+      void evict( const std::string& keep ) const;
+
+    private:
+      std::string m_directory;
+      size_t m_maxSize;
+    };
+
+  }
+
+}
+
+#endif
@@ -5,6 +5,7 @@
 #include "IOVSchema.h"
 #include "GTSchema.h"
 #include "RunInfoSchema.h"
+#include "PayloadCache.h"
 //
 #include "RelationalAccess/ConnectionService.h"
 #include "RelationalAccess/ISessionProxy.h"
@@ -70,6 +71,8 @@ namespace cond {
       std::unique_ptr<IIOVSchema> iovSchemaHandle; 
       std::unique_ptr<IGTSchema> gtSchemaHandle; 
       std::unique_ptr<IRunInfoSchema> runInfoSchemaHandle; 
+      // optional local copy of the payloads, shared by the sessions created by the same pool
+      std::shared_ptr<PayloadCache> payloadCache;
     };
 
   }
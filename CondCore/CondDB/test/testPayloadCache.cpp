@@ -0,0 +1,129 @@
+#include "FWCore/PluginManager/interface/PluginManager.h"
+#include "FWCore/PluginManager/interface/standard.h"
+#include "FWCore/PluginManager/interface/SharedLibrary.h"
+//
+#include "CondCore/CondDB/interface/ConnectionPool.h"
+//
+#include <boost/filesystem.hpp>
+//
+#include <ctime>
+#include <fstream>
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+using namespace cond::persistency;
+
+int readPayload( const std::string& connectionString, const std::string& cacheDir, const cond::Hash& payloadId, const std::string& expected,
+                 size_t maxSizeMB = 0 ){
+  ConnectionPool connPool;
+  connPool.setPayloadCache( cacheDir, maxSizeMB );
+  Session session = connPool.createSession( connectionString );
+  session.transaction().start();
+  std::shared_ptr<std::string> pay = session.fetchPayload<std::string>( payloadId );
+  session.transaction().commit();
+  // only the size of the large payloads is printed
+  std::string printed = expected.size() > 100 ? std::to_string( pay->size() ) + " characters" : "\"" + *pay + "\"";
+  if( *pay != expected ){
+    std::cout <<"#ERROR: read "<<printed<<" instead of the expected payload"<<std::endl;
+    return -1;
+  }
+  std::cout <<"#OK: read "<<printed<<std::endl;
+  return 0;
+}
+
+std::string cacheFile( const std::string& cacheDir, const cond::Hash& payloadId ){
+  return cacheDir + "/" + payloadId.substr( 0, 2 ) + "/" + payloadId;
+}
+
+int run( const std::string& connectionString, const std::string& otherConnectionString, const std::string& cacheDir ){
+  try{
+    boost::filesystem::remove_all( cacheDir );
+
+    //*************
+    std::cout <<"> Connecting with db in "<<connectionString<<std::endl;
+    ConnectionPool connPool;
+    Session session = connPool.createSession( connectionString, true );
+    session.transaction().start( false );
+    std::string pay0("Payload #0");
+    auto p0 = session.storePayload( pay0 );
+    session.transaction().commit();
+
+    // a database without payload #0
+    Session otherSession = connPool.createSession( otherConnectionString, true );
+    otherSession.transaction().start( false );
+    otherSession.storePayload( std::string( "Other payload" ) );
+    otherSession.transaction().commit();
+
+    // first read fills the cache
+    if( readPayload( connectionString, cacheDir, p0, pay0 ) ) return -1;
+    std::string cachedFile = cacheFile( cacheDir, p0 );
+    if( !boost::filesystem::exists( cachedFile ) ){
+      std::cout <<"#ERROR: payload "<<p0<<" not found in the cache"<<std::endl;
+      return -1;
+    }
+    // second read is served by the cache: the database used does not have the payload
+    std::cout <<"> Reading from the cache with db "<<otherConnectionString<<std::endl;
+    if( readPayload( otherConnectionString, cacheDir, p0, pay0 ) ) return -1;
+
+    // a damaged entry is ignored, the payload is taken again from the database and the entry rewritten
+    {
+      std::ofstream damaged( cachedFile, std::ios::binary | std::ios::trunc );
+      damaged << "garbage";
+    }
+    if( readPayload( connectionString, cacheDir, p0, pay0 ) ) return -1;
+    if( boost::filesystem::file_size( cachedFile ) <= 7 ){
+      std::cout <<"#ERROR: damaged cache entry not replaced"<<std::endl;
+      return -1;
+    }
+    boost::filesystem::remove_all( cacheDir );
+
+    // eviction: 3 payloads of 400 kB with a limit of 1 MB. The directory is given with a trailing '/'
+    // and a "./", which must not prevent the new entry from being recognized
+    std::cout <<"> Evicting with a size limit"<<std::endl;
+    std::vector<std::string> large;
+    std::vector<cond::Hash> largeIds;
+    session.transaction().start( false );
+    for( char c : { 'a', 'b', 'c' } ){
+      large.push_back( std::string( 400*1024, c ) );
+      largeIds.push_back( session.storePayload( large.back() ) );
+    }
+    session.transaction().commit();
+    const std::string limitedDir = cacheDir + "/./";
+    std::time_t now = std::time( nullptr );
+    for( unsigned int i = 0; i < 2; ++i ){
+      if( readPayload( connectionString, limitedDir, largeIds[i], large[i], 1 ) ) return -1;
+      // the first payload is the least recently used one
+      boost::filesystem::last_write_time( cacheFile( cacheDir, largeIds[i] ), now - 100 + 50*i );
+    }
+    if( readPayload( connectionString, limitedDir, largeIds[2], large[2], 1 ) ) return -1;
+    for( unsigned int i = 0; i < 3; ++i ){
+      if( boost::filesystem::exists( cacheFile( cacheDir, largeIds[i] ) ) != ( i != 0 ) ){
+        std::cout <<"#ERROR: payload "<<i<<( i == 0 ? " not evicted" : " evicted" )<<std::endl;
+        return -1;
+      }
+    }
+    // the evicted payload is taken again from the database
+    if( readPayload( connectionString, limitedDir, largeIds[0], large[0], 1 ) ) return -1;
+    boost::filesystem::remove_all( cacheDir );
+  } catch (const std::exception& e){
+    std::cout << "ERROR: " << e.what() << std::endl;
+    return -1;
+  } catch (...){
+    std::cout << "UNEXPECTED FAILURE." << std::endl;
+    return -1;
+  }
+  std::cout <<"## Run successfully completed."<<std::endl;
+  return 0;
+}
+
+int main (int argc, char** argv)
+{
+  int ret = 0;
+  edmplugin::PluginManager::Config config;
+  edmplugin::PluginManager::configure(edmplugin::standard::config());
+  std::string connectionString0("sqlite_file:cms_conditions_cache.db");
+  std::string connectionString1("sqlite_file:cms_conditions_cache_other.db");
+  ret = run( connectionString0, connectionString1, "testPayloadCache" );
+  return ret;
+}
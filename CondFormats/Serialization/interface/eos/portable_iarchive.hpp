@@ -200,6 +200,7 @@ namespace eos {
 		// as additional argument type for overloading
 		template <int> struct dummy { dummy(int) {}};
 
+	#if BOOST_VERSION < 103400
 		// loads directly from stream
 		inline signed char load_signed_char()
 		{ 
@@ -208,6 +209,32 @@ namespace eos {
 			return c; 
 		}
 
+		// loads the few value bytes of a primitive
+		inline void load_value_bytes(void* address, std::size_t count)
+		{
+			load_binary(address, count);
+		}
+	#else
+		// loads directly from stream buffer: every primitive is stored as a size byte
+		// followed by at most 8 value bytes, and the inline sbumpc is much cheaper for
+		// these than load_binary, which goes through the virtual streambuf::xsgetn
+		inline signed char load_signed_char()
+		{
+			std::istream::int_type c = m_sb.sbumpc();
+			if (std::istream::traits_type::eq_int_type(c, std::istream::traits_type::eof()))
+				throw boost::archive::archive_exception(
+					boost::archive::archive_exception::input_stream_error);
+			return static_cast<signed char>(std::istream::traits_type::to_char_type(c));
+		}
+
+		// loads the few value bytes of a primitive
+		inline void load_value_bytes(void* address, std::size_t count)
+		{
+			signed char* p = static_cast<signed char*>(address);
+			for (std::size_t i = 0; i < count; ++i) p[i] = load_signed_char();
+		}
+	#endif
+
 		// archive initialization
 		void init(unsigned flags)
 		{
@@ -343,7 +370,7 @@ namespace eos {
 
 				// reconstruct the value
 				T temp = size < 0 ? -1 : 0;
-				load_binary(&temp, abs(size));
+				load_value_bytes(&temp, abs(size));
 
 				// load the value from little endian - is is then converted
 				// to the target type T and fits it because size <= sizeof(T)
@@ -0,0 +1,171 @@
+// Round trip of mixed-width primitives through the eos portable archives.
+// The values read by portable_iarchive, which takes the size and value bytes
+// straight from the stream buffer, are compared with the values written and
+// with a reference decoding that goes through load_binary byte block by byte
+// block, as the archive did originally.
+
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <limits>
+#include <sstream>
+#include <stdexcept>
+#include <vector>
+
+#include <boost/archive/archive_exception.hpp>
+
+#include "CondFormats/Serialization/interface/eos/portable_iarchive.hpp"
+#include "CondFormats/Serialization/interface/eos/portable_oarchive.hpp"
+
+namespace {
+
+  // the original decoding of an integer: a size byte, then abs(size) little endian bytes
+  template <typename T>
+  T referenceLoad(eos::portable_iarchive & ar)
+  {
+    signed char size;
+    ar.load_binary(&size, 1);
+    if (size == 0)
+      return 0;
+    T temp = size < 0 ? -1 : 0;
+    ar.load_binary(&temp, std::abs(size));
+    return endian::load_little_endian<T, sizeof(T)>(&temp);
+  }
+
+  template <typename F, typename I>
+  F referenceLoadFloat(eos::portable_iarchive & ar)
+  {
+    const I bits = referenceLoad<I>(ar);
+    F f;
+    std::memcpy(&f, &bits, sizeof(F));
+    return f;
+  }
+
+  template <typename T>
+  std::vector<T> integers()
+  {
+    std::vector<T> ret = {T(0), T(1), T(2), T(0x7f), T(0x80), T(0xff),
+                          std::numeric_limits<T>::max(), T(std::numeric_limits<T>::max() - 1),
+                          std::numeric_limits<T>::min(), T(std::numeric_limits<T>::min() + 1)};
+    if (std::numeric_limits<T>::is_signed) {
+      for (T x : {T(-1), T(-2), T(-0x7f), T(-0x80), T(-0x81)})
+        ret.push_back(x);
+    }
+    if (sizeof(T) > 2) {
+      ret.push_back(T(0x12345));
+      ret.push_back(T(0x7fffff));
+    }
+    return ret;
+  }
+
+  template <typename T>
+  void check(bool ok, const T & expected, const char * what)
+  {
+    if (not ok) {
+      std::ostringstream s;
+      s << what << ": wrong value for " << +expected << " (" << typeid(T).name() << ")";
+      throw std::logic_error(s.str());
+    }
+  }
+
+  template <typename F>
+  bool sameBits(F a, F b)
+  {
+    return std::memcmp(&a, &b, sizeof(F)) == 0;
+  }
+
+  // one of each value, in an order mixing all the widths
+  struct Values {
+    std::vector<int8_t> i8 = integers<int8_t>();
+    std::vector<uint8_t> u8 = integers<uint8_t>();
+    std::vector<int16_t> i16 = integers<int16_t>();
+    std::vector<uint16_t> u16 = integers<uint16_t>();
+    std::vector<int32_t> i32 = integers<int32_t>();
+    std::vector<uint32_t> u32 = integers<uint32_t>();
+    std::vector<int64_t> i64 = integers<int64_t>();
+    std::vector<uint64_t> u64 = integers<uint64_t>();
+    std::vector<float> f = {0.f, -0.f, 1.f, -1.5f, 3.4e38f, -1e-40f, std::numeric_limits<float>::infinity()};
+    std::vector<double> d = {0., -0., 1., -1.5, 1.7e308, -1e-310, -std::numeric_limits<double>::infinity()};
+
+    template <typename Op>
+    void forEach(Op op)
+    {
+      for (unsigned int i = 0; i < i64.size(); ++i) {
+        if (i < i8.size()) op(i8[i]);
+        if (i < u64.size()) op(u64[i]);
+        if (i < u16.size()) op(u16[i]);
+        if (i < f.size()) op(f[i]);
+        if (i < i32.size()) op(i32[i]);
+        if (i < u8.size()) op(u8[i]);
+        if (i < d.size()) op(d[i]);
+        if (i < i16.size()) op(i16[i]);
+        if (i < u32.size()) op(u32[i]);
+        op(i64[i]);
+      }
+    }
+  };
+
+  struct Reference {
+    eos::portable_iarchive & ar;
+    template <typename T> T load(T) { return referenceLoad<T>(ar); }
+    float load(float) { return referenceLoadFloat<float, uint32_t>(ar); }
+    double load(double) { return referenceLoadFloat<double, uint64_t>(ar); }
+  };
+
+  template <typename T>
+  bool same(T a, T b) { return a == b; }
+  bool same(float a, float b) { return sameBits(a, b); }
+  bool same(double a, double b) { return sameBits(a, b); }
+
+}
+
+int main()
+{
+  Values values;
+
+  std::ostringstream os(std::ios::binary);
+  {
+    eos::portable_oarchive oa(os);
+    values.forEach([&](auto x) { oa << x; });
+  }
+  const std::string buffer = os.str();
+
+  // the stream buffer path
+  {
+    std::istringstream is(buffer, std::ios::binary);
+    eos::portable_iarchive ia(is);
+    values.forEach([&](auto x) {
+      decltype(x) y;
+      ia >> y;
+      check(same(x, y), x, "portable_iarchive");
+    });
+  }
+
+  // the original load_binary path
+  {
+    std::istringstream is(buffer, std::ios::binary);
+    eos::portable_iarchive ia(is);
+    Reference reference{ia};
+    values.forEach([&](auto x) { check(same(x, reference.load(x)), x, "load_binary"); });
+  }
+
+  // a truncated stream throws instead of returning garbage
+  {
+    std::istringstream is(buffer.substr(0, buffer.size() - 3), std::ios::binary);
+    eos::portable_iarchive ia(is);
+    bool thrown = false;
+    try {
+      values.forEach([&](auto x) {
+        decltype(x) y;
+        ia >> y;
+      });
+    } catch (boost::archive::archive_exception const & e) {
+      thrown = e.code == boost::archive::archive_exception::input_stream_error;
+    }
+    if (not thrown)
+      throw std::logic_error("Reading past the end of the stream did not throw.");
+  }
+
+  std::cout << "Read back " << buffer.size() << " bytes" << std::endl;
+  return 0;
+}
@@ -23,18 +23,41 @@ namespace logintpack
         }
 
 
+        namespace detail
+        {
+                /// the rounding threshold of pack16log, which does not depend on the value
+                inline float pack16logDelta(double lmin, double lmax, uint16_t base)
+                {
+                        return (log(1.+exp((lmax-lmin)/base))-log(2.))*base/(lmax-lmin);
+                }
+
+                inline int16_t pack16log(double x,double lmin, double lmax, uint16_t base, float delta)
+                {
+                        const double l = std::log(std::abs(x));
+                        const double centered = (l-lmin)/(lmax-lmin)*base;
+                        int16_t  r=std::floor(centered);
+                        if(centered-r>delta) r+=1;
+                        if(centered >= base-1) r=base-1;
+                        if(centered < 0) r=0;
+                        if(x<0) r = r==0 ? -1 : -r;
+                        return r;
+                }
+        }
+
 	inline int16_t pack16log(double x,double lmin, double lmax, uint16_t base=32768)
 	{
 	        if(base>32768) base=32768;
-                const float delta=(log(1.+exp((lmax-lmin)/base))-log(2.))*base/(lmax-lmin);
-		const double l = std::log(std::abs(x));
-		const double centered = (l-lmin)/(lmax-lmin)*base;
-		int16_t  r=std::floor(centered);
-		if(centered-r>delta) r+=1;
-		if(centered >= base-1) r=base-1;
-		if(centered < 0) r=0;
-		if(x<0) r = r==0 ? -1 : -r;
-		return r;
+                return detail::pack16log(x, lmin, lmax, base, detail::pack16logDelta(lmin, lmax, base));
+	}
+
+	/// array version of pack16log: packs the n values of 'in' into 'out', with the
+	/// same results, but computes the rounding threshold (two logs and one exp) once
+	template<typename T>
+	inline void pack16log(const T *in, int16_t *out, unsigned int n, double lmin, double lmax, uint16_t base=32768)
+	{
+	        if(base>32768) base=32768;
+                const float delta = detail::pack16logDelta(lmin, lmax, base);
+                for (unsigned int i = 0; i < n; ++i) out[i] = detail::pack16log(in[i], lmin, lmax, base, delta);
 	}
 
         /// pack a value x distributed in [-1,1], with guarantee that -1 and 1 are preserved exactly in packing and unpacking.
@@ -137,5 +160,80 @@ namespace logintpack
 		if(i<0) return -val; else return val;
 	}
 
+        /// Array versions of the functions above: (un)pack the n values of 'in' into 'out',
+        /// with the same results as calling the scalar function on each of them. They
+        /// still go through std::log and std::exp one value at a time, as a vectorized
+        /// log or exp would not be bitwise identical to libm.
+        template<typename T>
+        inline void pack16logCeil(const T *in, int16_t *out, unsigned int n, double lmin, double lmax, uint16_t base=32768)
+        {
+                for (unsigned int i = 0; i < n; ++i) out[i] = pack16logCeil(in[i], lmin, lmax, base);
+        }
+
+        template<typename T>
+        inline void pack16logClosed(const T *in, int16_t *out, unsigned int n, double lmin, double lmax, uint16_t base=32768)
+        {
+                for (unsigned int i = 0; i < n; ++i) out[i] = pack16logClosed(in[i], lmin, lmax, base);
+        }
+
+        template<typename T>
+        inline void unpack16log(const int16_t *in, T *out, unsigned int n, double lmin, double lmax, uint16_t base=32768)
+        {
+                for (unsigned int i = 0; i < n; ++i) out[i] = unpack16log(in[i], lmin, lmax, base);
+        }
+
+        template<typename T>
+        inline void unpack16logClosed(const int16_t *in, T *out, unsigned int n, double lmin, double lmax, uint16_t base=32768)
+        {
+                for (unsigned int i = 0; i < n; ++i) out[i] = unpack16logClosed(in[i], lmin, lmax, base);
+        }
+
+        template<typename T>
+        inline void pack8logCeil(const T *in, int8_t *out, unsigned int n, double lmin, double lmax, uint8_t base=128)
+        {
+                for (unsigned int i = 0; i < n; ++i) out[i] = pack8logCeil(in[i], lmin, lmax, base);
+        }
+
+        template<typename T>
+        inline void pack8log(const T *in, int8_t *out, unsigned int n, double lmin, double lmax, uint8_t base=128)
+        {
+                for (unsigned int i = 0; i < n; ++i) out[i] = pack8log(in[i], lmin, lmax, base);
+        }
+
+        template<typename T>
+        inline void pack8logClosed(const T *in, int8_t *out, unsigned int n, double lmin, double lmax, uint8_t base=128)
+        {
+                for (unsigned int i = 0; i < n; ++i) out[i] = pack8logClosed(in[i], lmin, lmax, base);
+        }
+
+        namespace detail
+        {
+                /// an int8_t takes only 256 values: when there are more than that to unpack,
+                /// the results are computed once for each of them and looked up
+                template<typename T, typename F>
+                inline void unpack8(const int8_t *in, T *out, unsigned int n, F unpacker)
+                {
+                        if (n <= 256) {
+                                for (unsigned int i = 0; i < n; ++i) out[i] = unpacker(in[i]);
+                                return;
+                        }
+                        T table[256];
+                        for (int i = -128; i < 128; ++i) table[uint8_t(i)] = unpacker(int8_t(i));
+                        for (unsigned int i = 0; i < n; ++i) out[i] = table[uint8_t(in[i])];
+                }
+        }
+
+        template<typename T>
+        inline void unpack8log(const int8_t *in, T *out, unsigned int n, double lmin, double lmax, uint8_t base=128)
+        {
+                detail::unpack8(in, out, n, [=](int8_t i) { return unpack8log(i, lmin, lmax, base); });
+        }
+
+        template<typename T>
+        inline void unpack8logClosed(const int8_t *in, T *out, unsigned int n, double lmin, double lmax, uint8_t base=128)
+        {
+                detail::unpack8(in, out, n, [=](int8_t i) { return unpack8logClosed(i, lmin, lmax, base); });
+        }
+
 }
 #endif
@@ -37,6 +37,17 @@ class MiniFloatConverter {
                 return basetable[(conv.i32>>23)&0x1ff]+((conv.i32&0x007fffff)>>shifttable[(conv.i32>>23)&0x1ff]);
             }
         }
+        /// Array versions of float16to32, float32to16 (rounding) and float32to16crop:
+        /// convert the n values of 'in' into 'out'. The results are bitwise identical
+        /// to those of the scalar functions; on x86 they are computed with SSE2 bit
+        /// manipulation instead of table lookups, four or eight values at a time.
+        static void float16to32(const uint16_t *in, float *out, unsigned int n) ;
+        static void float32to16(const float *in, uint16_t *out, unsigned int n) {
+            float32to16round(in, out, n);
+        }
+        static void float32to16crop(const float *in, uint16_t *out, unsigned int n) ;
+        static void float32to16round(const float *in, uint16_t *out, unsigned int n) ;
+
         template<int bits>
         inline static float reduceMantissaToNbits(const float &f)
         {
@@ -77,6 +88,8 @@ class MiniFloatConverter {
                     }
                     return conv.flt;
                 }
+                /// the same on the n values of 'in', written to 'out' (which can be 'in')
+                void operator()(const float *in, float *out, unsigned int n) const ;
             private:
                 const int shift;
                 const uint32_t mask, test, maxn;           
@@ -101,6 +114,13 @@ class MiniFloatConverter {
         {
             std::transform(begin, end, out, ReduceMantissaToNbitsRounding(bits));
         }
+
+        /// array version, bitwise identical to the scalar one but vectorized
+        inline static void reduceMantissaToNbitsRounding(const float *in, float *out, unsigned int n, int bits)
+        {
+            const ReduceMantissaToNbitsRounding reducer(bits);
+            reducer(in, out, n);
+        }
         
 
         inline static float max() {
@@ -1,5 +1,9 @@
 #include "DataFormats/Math/interface/libminifloat.h"
 
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
 namespace {
     MiniFloatConverter dummy; // so the constructor is called
 }
@@ -80,3 +84,119 @@ void MiniFloatConverter::filltables() {
         }
     }
 }
+
+#if defined(__SSE2__)
+namespace {
+    // float16 -> float32 of four values (in the low 16 bits of each lane), without
+    // tables: normals and inf/nan are rebiased, denormals are normalized by the FPU
+    inline __m128i half2float(__m128i h) {
+        const __m128i sign = _mm_slli_epi32(_mm_and_si128(h, _mm_set1_epi32(0x8000)), 16);
+        const __m128i exp = _mm_and_si128(h, _mm_set1_epi32(0x7c00));
+        const __m128i bits = _mm_slli_epi32(_mm_and_si128(h, _mm_set1_epi32(0x7fff)), 13);
+        // exponent 1..30: add 127-15 to the exponent; exponent 31: add it twice, to 255
+        __m128i norm = _mm_add_epi32(bits, _mm_set1_epi32(0x38000000));
+        norm = _mm_add_epi32(norm, _mm_and_si128(_mm_cmpeq_epi32(exp, _mm_set1_epi32(0x7c00)), _mm_set1_epi32(0x38000000)));
+        // exponent 0: mantissa * 2^-24 = (2^-14 + mantissa * 2^-24) - 2^-14, exact
+        const __m128i magic = _mm_set1_epi32(0x38800000);
+        const __m128i denorm = _mm_castps_si128(_mm_sub_ps(_mm_castsi128_ps(_mm_add_epi32(bits, magic)), _mm_castsi128_ps(magic)));
+        const __m128i isDenorm = _mm_cmpeq_epi32(exp, _mm_setzero_si128());
+        return _mm_or_si128(sign, _mm_or_si128(_mm_and_si128(isDenorm, denorm), _mm_andnot_si128(isDenorm, norm)));
+    }
+
+    // float32 -> float16 of four values, in the low 16 bits of each lane, as basetable
+    // and shifttable do: denormals and the values below are cropped, normals and
+    // inf/nan are cropped or rounded (without carry into the exponent), the values
+    // above max32RoundedToMax16() and the float32 infinities go to inf
+    template<bool round>
+    inline __m128i float2half(__m128 x) {
+        const __m128i i32 = _mm_castps_si128(x);
+        const __m128i sign = _mm_and_si128(_mm_srli_epi32(i32, 16), _mm_set1_epi32(0x8000));
+        const __m128i abs = _mm_and_si128(i32, _mm_set1_epi32(0x7fffffff));
+        const __m128i exp = _mm_srli_epi32(abs, 23);
+        // exponent 113..142 -> 1..30, 255 -> 31
+        const __m128i isMax = _mm_cmpeq_epi32(exp, _mm_set1_epi32(255));
+        const __m128i exp16 = _mm_or_si128(_mm_andnot_si128(isMax, _mm_sub_epi32(exp, _mm_set1_epi32(112))),
+                                           _mm_and_si128(isMax, _mm_set1_epi32(31)));
+        const __m128i mantissa = _mm_and_si128(i32, _mm_set1_epi32(0x007fffff));
+        __m128i mantissa16 = _mm_srli_epi32(mantissa, 13);
+        if (round) {
+            const __m128i half = _mm_and_si128(_mm_srli_epi32(mantissa, 12), _mm_set1_epi32(1));
+            const __m128i notFull = _mm_cmplt_epi32(mantissa16, _mm_set1_epi32(1023));
+            mantissa16 = _mm_add_epi32(mantissa16, _mm_and_si128(half, notFull));
+        }
+        const __m128i norm = _mm_add_epi32(_mm_slli_epi32(exp16, 10), mantissa16);
+        // exponent below 113: the denormal (or zero) is (1.mantissa) >> (126 - exponent),
+        // i.e. |x| * 2^24 truncated
+        const __m128i denorm = _mm_cvttps_epi32(_mm_mul_ps(_mm_castsi128_ps(abs), _mm_set1_ps(16777216.f)));
+        const __m128i isDenorm = _mm_cmplt_epi32(exp, _mm_set1_epi32(113));
+        const __m128i isInf = _mm_andnot_si128(isMax, _mm_cmpgt_epi32(exp, _mm_set1_epi32(142)));
+        __m128i h = _mm_or_si128(_mm_and_si128(isDenorm, denorm), _mm_andnot_si128(isDenorm, norm));
+        h = _mm_or_si128(_mm_and_si128(isInf, _mm_set1_epi32(0x7c00)), _mm_andnot_si128(isInf, h));
+        return _mm_or_si128(sign, h);
+    }
+
+    // 32 -> 16 bits of eight values in [0, 0xffff], with the signed saturation of SSE2
+    inline __m128i pack16(__m128i lo, __m128i hi) {
+        return _mm_packs_epi32(_mm_srai_epi32(_mm_slli_epi32(lo, 16), 16), _mm_srai_epi32(_mm_slli_epi32(hi, 16), 16));
+    }
+
+    template<bool round>
+    inline unsigned int float32to16sse(const float *in, uint16_t *out, unsigned int n) {
+        unsigned int i = 0;
+        for (; i + 8 <= n; i += 8) {
+            const __m128i lo = float2half<round>(_mm_loadu_ps(in + i));
+            const __m128i hi = float2half<round>(_mm_loadu_ps(in + i + 4));
+            _mm_storeu_si128(reinterpret_cast<__m128i *>(out + i), pack16(lo, hi));
+        }
+        return i;
+    }
+}
+#endif
+
+void MiniFloatConverter::float16to32(const uint16_t *in, float *out, unsigned int n) {
+    unsigned int i = 0;
+#if defined(__SSE2__)
+    const __m128i zero = _mm_setzero_si128();
+    for (; i + 8 <= n; i += 8) {
+        const __m128i h = _mm_loadu_si128(reinterpret_cast<const __m128i *>(in + i));
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(out + i), half2float(_mm_unpacklo_epi16(h, zero)));
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(out + i + 4), half2float(_mm_unpackhi_epi16(h, zero)));
+    }
+#endif
+    for (; i < n; ++i) out[i] = float16to32(in[i]);
+}
+
+void MiniFloatConverter::float32to16crop(const float *in, uint16_t *out, unsigned int n) {
+    unsigned int i = 0;
+#if defined(__SSE2__)
+    i = float32to16sse<false>(in, out, n);
+#endif
+    for (; i < n; ++i) out[i] = float32to16crop(in[i]);
+}
+
+void MiniFloatConverter::float32to16round(const float *in, uint16_t *out, unsigned int n) {
+    unsigned int i = 0;
+#if defined(__SSE2__)
+    i = float32to16sse<true>(in, out, n);
+#endif
+    for (; i < n; ++i) out[i] = float32to16round(in[i]);
+}
+
+void MiniFloatConverter::ReduceMantissaToNbitsRounding::operator()(const float *in, float *out, unsigned int n) const {
+    unsigned int i = 0;
+#if defined(__SSE2__)
+    const __m128i vshift = _mm_cvtsi32_si128(shift);
+    const __m128i vmask = _mm_set1_epi32(mask), vtest = _mm_set1_epi32(test), vmaxn = _mm_set1_epi32(maxn);
+    const __m128i low23 = _mm_set1_epi32(0x007FFFFF), hi9 = _mm_set1_epi32(0xFF800000);
+    for (; i + 4 <= n; i += 4) {
+        const __m128i x = _mm_castps_si128(_mm_loadu_ps(in + i));
+        const __m128i doRound = _mm_cmpeq_epi32(_mm_and_si128(x, vtest), vtest);
+        __m128i mantissa = _mm_srl_epi32(_mm_and_si128(x, low23), vshift);
+        mantissa = _mm_sub_epi32(mantissa, _mm_cmplt_epi32(mantissa, vmaxn)); // +1 where below maxn
+        const __m128i rounded = _mm_or_si128(_mm_and_si128(x, hi9), _mm_sll_epi32(mantissa, vshift));
+        const __m128i cropped = _mm_and_si128(x, vmask);
+        _mm_storeu_ps(out + i, _mm_castsi128_ps(_mm_or_si128(_mm_and_si128(doRound, rounded), _mm_andnot_si128(doRound, cropped))));
+    }
+#endif
+    for (; i < n; ++i) out[i] = (*this)(in[i]);
+}
@@ -0,0 +1,90 @@
+// Throughput of the scalar and array versions of the miniAOD packing functions:
+// prints the time per value of each, over a few arrays of random values.
+
+#include "DataFormats/Math/interface/libminifloat.h"
+#include "DataFormats/Math/interface/liblogintpack.h"
+
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+namespace {
+  constexpr unsigned int kSize = 4096;
+  constexpr unsigned int kRepeat = 2000;
+
+  template<typename F>
+  double timePerValue(F f) {
+    f(); // warm up
+    const auto start = std::chrono::steady_clock::now();
+    for (unsigned int i = 0; i < kRepeat; ++i) f();
+    const std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+    return elapsed.count() / (double(kRepeat) * kSize);
+  }
+
+  void print(const char *name, double scalar, double array) {
+    std::printf("%-32s %8.3f ns %8.3f ns %6.2fx\n", name, scalar, array, scalar / array);
+  }
+
+  // keeps the compiler from optimizing the loops away
+  template<typename T>
+  void use(const std::vector<T> &v) {
+    volatile T sink = v[v.size() / 2];
+    (void)sink;
+  }
+}
+
+int main() {
+  std::mt19937 gen(42);
+  std::uniform_real_distribution<float> flat(-2.f, 2.f);
+  std::uniform_int_distribution<int> bits16(0, 0xffff);
+
+  std::vector<float> floats(kSize), floatsOut(kSize);
+  std::vector<uint16_t> halves(kSize), halvesOut(kSize);
+  std::vector<int16_t> logs(kSize);
+  std::vector<double> doubles(kSize);
+  for (unsigned int i = 0; i < kSize; ++i) {
+    floats[i] = std::ldexp(flat(gen), int(flat(gen) * 8));
+    halves[i] = bits16(gen);
+    logs[i] = int16_t(bits16(gen) % 4095 - 2047);
+  }
+
+  std::printf("%-32s %11s %11s %7s\n", "", "scalar", "array", "speedup");
+
+  print("float16to32",
+        timePerValue([&] { for (unsigned int i = 0; i < kSize; ++i) floatsOut[i] = MiniFloatConverter::float16to32(halves[i]); }),
+        timePerValue([&] { MiniFloatConverter::float16to32(halves.data(), floatsOut.data(), kSize); }));
+  use(floatsOut);
+
+  print("float32to16 (round)",
+        timePerValue([&] { for (unsigned int i = 0; i < kSize; ++i) halvesOut[i] = MiniFloatConverter::float32to16(floats[i]); }),
+        timePerValue([&] { MiniFloatConverter::float32to16(floats.data(), halvesOut.data(), kSize); }));
+  use(halvesOut);
+
+  print("float32to16crop",
+        timePerValue([&] { for (unsigned int i = 0; i < kSize; ++i) halvesOut[i] = MiniFloatConverter::float32to16crop(floats[i]); }),
+        timePerValue([&] { MiniFloatConverter::float32to16crop(floats.data(), halvesOut.data(), kSize); }));
+  use(halvesOut);
+
+  const MiniFloatConverter::ReduceMantissaToNbitsRounding reducer(10);
+  print("reduceMantissaToNbitsRounding",
+        timePerValue([&] { for (unsigned int i = 0; i < kSize; ++i) floatsOut[i] = reducer(floats[i]); }),
+        timePerValue([&] { MiniFloatConverter::reduceMantissaToNbitsRounding(floats.data(), floatsOut.data(), kSize, 10); }));
+  use(floatsOut);
+
+  // as in CovarianceParameterization, 11 bits in [-15, 0]
+  constexpr uint16_t base = 1 << 11;
+  print("pack16log",
+        timePerValue([&] { for (unsigned int i = 0; i < kSize; ++i) logs[i] = logintpack::pack16log(floats[i], -15, 0, base); }),
+        timePerValue([&] { logintpack::pack16log(floats.data(), logs.data(), kSize, -15, 0, base); }));
+  use(logs);
+
+  print("unpack16log",
+        timePerValue([&] { for (unsigned int i = 0; i < kSize; ++i) doubles[i] = logintpack::unpack16log(logs[i], -15, 0, base); }),
+        timePerValue([&] { logintpack::unpack16log(logs.data(), doubles.data(), kSize, -15, 0, base); }));
+  use(doubles);
+
+  return 0;
+}
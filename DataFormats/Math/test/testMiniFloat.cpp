@@ -1,5 +1,7 @@
 #include <cppunit/extensions/HelperMacros.h>
 #include <iostream>
+#include <cstring>
+#include <vector>
 
 #include "DataFormats/Math/interface/libminifloat.h"
 #include "FWCore/Utilities/interface/isFinite.h"
@@ -13,6 +15,9 @@ class testMiniFloat : public CppUnit::TestFixture {
   CPPUNIT_TEST(testMin);
   CPPUNIT_TEST(testMin32RoundedToMin16);
   CPPUNIT_TEST(testDenormMin);
+  CPPUNIT_TEST(testArrayFloat16to32);
+  CPPUNIT_TEST(testArrayFloat32to16);
+  CPPUNIT_TEST(testArrayReduceMantissa);
 
   CPPUNIT_TEST_SUITE_END();
 public:
@@ -25,12 +30,38 @@ public:
   void testMin();
   void testMin32RoundedToMin16();
   void testDenormMin();
+  void testArrayFloat16to32();
+  void testArrayFloat32to16();
+  void testArrayReduceMantissa();
 
 private:
 };
 
 CPPUNIT_TEST_SUITE_REGISTRATION(testMiniFloat);
 
+namespace {
+  bool sameBits(float a, float b) { return std::memcmp(&a, &b, sizeof(float)) == 0; }
+
+  float fromBits(uint32_t i) { float f; std::memcpy(&f, &i, sizeof(float)); return f; }
+
+  // the float32 values at and around the rounding boundaries of all the float16 values,
+  // plus all the float32 exponents (including denormals, inf and nan) with a few mantissas
+  std::vector<float> float32Inputs() {
+    std::vector<float> ret;
+    for (uint32_t h = 0; h < (1 << 16); ++h) {
+      union { float flt; uint32_t i32; } conv;
+      conv.flt = MiniFloatConverter::float16to32(h);
+      for (uint32_t i32 : {conv.i32 - 1, conv.i32, conv.i32 + 1, conv.i32 + 0xfff, conv.i32 + 0x1000, conv.i32 + 0x1001}) {
+        ret.push_back(fromBits(i32));
+      }
+      for (uint32_t low : {0x0u, 0x1u, 0x1000u, 0xffffu}) {
+        ret.push_back(fromBits((h << 16) | low));
+      }
+    }
+    return ret;
+  }
+}
+
 void testMiniFloat::testIsDenorm() {
   // all float16s with zero exponent and non-zero mantissa are denormals, test here the boundaries
   CPPUNIT_ASSERT(MiniFloatConverter::isdenorm(1));
@@ -113,3 +144,48 @@ void testMiniFloat::testDenormMin() {
   const float min32MinusUlp32CroppedTo16 = MiniFloatConverter::float16to32(MiniFloatConverter::float32to16crop(conv.flt));
   CPPUNIT_ASSERT(min32MinusUlp32CroppedTo16 == 0.f);
 }
+
+void testMiniFloat::testArrayFloat16to32() {
+  // all the 2^16 float16 values, with an odd size to go through the scalar remainder
+  std::vector<uint16_t> in;
+  for (uint32_t h = 0; h < (1 << 16); ++h) in.push_back(h);
+  in.push_back(0x3c00);
+  std::vector<float> out(in.size());
+  MiniFloatConverter::float16to32(in.data(), out.data(), in.size());
+  for (unsigned int i = 0; i < in.size(); ++i) {
+    CPPUNIT_ASSERT(sameBits(out[i], MiniFloatConverter::float16to32(in[i])));
+  }
+}
+
+void testMiniFloat::testArrayFloat32to16() {
+  const std::vector<float> in = float32Inputs();
+  std::vector<uint16_t> round(in.size() - 3), crop(in.size() - 3);
+  MiniFloatConverter::float32to16round(in.data(), round.data(), round.size());
+  MiniFloatConverter::float32to16crop(in.data(), crop.data(), crop.size());
+  for (unsigned int i = 0; i < round.size(); ++i) {
+    CPPUNIT_ASSERT(round[i] == MiniFloatConverter::float32to16round(in[i]));
+    CPPUNIT_ASSERT(crop[i] == MiniFloatConverter::float32to16crop(in[i]));
+  }
+  MiniFloatConverter::float32to16(in.data(), round.data(), round.size());
+  for (unsigned int i = 0; i < round.size(); ++i) {
+    CPPUNIT_ASSERT(round[i] == MiniFloatConverter::float32to16(in[i]));
+  }
+}
+
+void testMiniFloat::testArrayReduceMantissa() {
+  const std::vector<float> in = float32Inputs();
+  std::vector<float> out(in.size() - 1);
+  for (int bits = 1; bits < 23; ++bits) {
+    const MiniFloatConverter::ReduceMantissaToNbitsRounding reducer(bits);
+    MiniFloatConverter::reduceMantissaToNbitsRounding(in.data(), out.data(), out.size(), bits);
+    for (unsigned int i = 0; i < out.size(); ++i) {
+      CPPUNIT_ASSERT(sameBits(out[i], reducer(in[i])));
+    }
+  }
+  // in place
+  std::vector<float> inPlace(in);
+  MiniFloatConverter::reduceMantissaToNbitsRounding(inPlace.data(), inPlace.data(), inPlace.size(), 10);
+  for (unsigned int i = 0; i < in.size(); ++i) {
+    CPPUNIT_ASSERT(sameBits(inPlace[i], MiniFloatConverter::reduceMantissaToNbitsRounding(in[i], 10)));
+  }
+}
@@ -2,6 +2,8 @@
 #include <iostream>
 #include <iomanip>
 #include <limits>
+#include <cstring>
+#include <vector>
 
 #include "DataFormats/Math/interface/liblogintpack.h"
 
@@ -10,6 +12,8 @@ class testlogintpack : public CppUnit::TestFixture {
 
   CPPUNIT_TEST(test16base11);
   CPPUNIT_TEST(test8);
+  CPPUNIT_TEST(testArrays16);
+  CPPUNIT_TEST(testArrays8);
 
   CPPUNIT_TEST_SUITE_END();
 public:
@@ -18,6 +22,8 @@ public:
 
   void test16base11();
   void test8();
+  void testArrays16();
+  void testArrays8();
 
 private:
 };
@@ -191,5 +197,87 @@ void testlogintpack::test8() {
 
 }
 
+namespace {
+  template<typename T>
+  bool sameBits(T a, T b) { return std::memcmp(&a, &b, sizeof(T)) == 0; }
+}
+
+void testlogintpack::testArrays16() {
+  // all the 2^16 packed values, and the values they unpack to (in double and in
+  // float precision) and their neighbours to pack, with both bases
+  std::vector<int16_t> packed;
+  for (int i = std::numeric_limits<int16_t>::min(); i <= std::numeric_limits<int16_t>::max(); ++i) packed.push_back(i);
+
+  for (uint16_t base : {uint16_t(1 << 11), uint16_t(32768)}) {
+    std::vector<double> unpacked(packed.size()), unpackedClosed(packed.size());
+    std::vector<float> unpackedFloat(packed.size());
+    logintpack::unpack16log(packed.data(), unpacked.data(), packed.size(), -15, 0, base);
+    logintpack::unpack16logClosed(packed.data(), unpackedClosed.data(), packed.size(), -15, 0, base);
+    logintpack::unpack16log(packed.data(), unpackedFloat.data(), packed.size(), -15, 0, base);
+    for (unsigned int i = 0; i < packed.size(); ++i) {
+      CPPUNIT_ASSERT(sameBits(unpacked[i], logintpack::unpack16log(packed[i], -15, 0, base)));
+      CPPUNIT_ASSERT(sameBits(unpackedClosed[i], logintpack::unpack16logClosed(packed[i], -15, 0, base)));
+      CPPUNIT_ASSERT(sameBits(unpackedFloat[i], float(logintpack::unpack16log(packed[i], -15, 0, base))));
+    }
+
+    std::vector<double> values;
+    for (double x : unpacked) {
+      values.push_back(x);
+      values.push_back(std::nextafter(x, 0.));
+      values.push_back(std::nextafter(x, 2 * x));
+    }
+    values.push_back(0.);
+    std::vector<int16_t> out(values.size()), outCeil(values.size()), outClosed(values.size());
+    logintpack::pack16log(values.data(), out.data(), values.size(), -15, 0, base);
+    logintpack::pack16logCeil(values.data(), outCeil.data(), values.size(), -15, 0, base);
+    logintpack::pack16logClosed(values.data(), outClosed.data(), values.size(), -15, 0, base);
+    for (unsigned int i = 0; i < values.size(); ++i) {
+      CPPUNIT_ASSERT(out[i] == logintpack::pack16log(values[i], -15, 0, base));
+      CPPUNIT_ASSERT(outCeil[i] == logintpack::pack16logCeil(values[i], -15, 0, base));
+      CPPUNIT_ASSERT(outClosed[i] == logintpack::pack16logClosed(values[i], -15, 0, base));
+    }
+
+    std::vector<int16_t> outFloat(unpackedFloat.size());
+    logintpack::pack16log(unpackedFloat.data(), outFloat.data(), unpackedFloat.size(), -15, 0, base);
+    for (unsigned int i = 0; i < unpackedFloat.size(); ++i) {
+      CPPUNIT_ASSERT(outFloat[i] == logintpack::pack16log(unpackedFloat[i], -15, 0, base));
+    }
+  }
+}
+
+void testlogintpack::testArrays8() {
+  // all the 2^8 packed values, twice to go through the lookup table, and once alone
+  std::vector<int8_t> packed;
+  for (int j = 0; j < 2; ++j) {
+    for (int i = std::numeric_limits<int8_t>::min(); i <= std::numeric_limits<int8_t>::max(); ++i) packed.push_back(i);
+  }
+  for (unsigned int n : {256u, unsigned(packed.size())}) {
+    std::vector<double> unpacked(n), unpackedClosed(n);
+    logintpack::unpack8log(packed.data(), unpacked.data(), n, -15, 0);
+    logintpack::unpack8logClosed(packed.data(), unpackedClosed.data(), n, -15, 0);
+    for (unsigned int i = 0; i < n; ++i) {
+      CPPUNIT_ASSERT(sameBits(unpacked[i], unpack(packed[i])));
+      CPPUNIT_ASSERT(sameBits(unpackedClosed[i], unpackclosed(packed[i])));
+    }
+  }
+
+  std::vector<double> values;
+  for (int i = std::numeric_limits<int8_t>::min(); i <= std::numeric_limits<int8_t>::max(); ++i) {
+    const double x = unpack(i);
+    values.push_back(x);
+    values.push_back(std::nextafter(x, 0.));
+    values.push_back(std::nextafter(x, 2 * x));
+  }
+  std::vector<int8_t> out(values.size()), outCeil(values.size()), outClosed(values.size());
+  logintpack::pack8log(values.data(), out.data(), values.size(), -15, 0);
+  logintpack::pack8logCeil(values.data(), outCeil.data(), values.size(), -15, 0);
+  logintpack::pack8logClosed(values.data(), outClosed.data(), values.size(), -15, 0);
+  for (unsigned int i = 0; i < values.size(); ++i) {
+    CPPUNIT_ASSERT(out[i] == pack(values[i]));
+    CPPUNIT_ASSERT(outCeil[i] == packceil(values[i]));
+    CPPUNIT_ASSERT(outClosed[i] == logintpack::pack8logClosed(values[i], -15, 0));
+  }
+}
+
 CPPUNIT_TEST_SUITE_REGISTRATION(testlogintpack);
 
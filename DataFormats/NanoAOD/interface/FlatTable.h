@@ -20,7 +20,7 @@ namespace flatTableHelper {
         int bits_; 
         MaybeMantissaReduce(int mantissaBits) : bits_(mantissaBits) {}
         inline float one(const float &val) const  { return (bits_ > 0 ? MiniFloatConverter::reduceMantissaToNbitsRounding(val, bits_) : val); }
-        inline void bulk(boost::sub_range<std::vector<float>> data) const { if (bits_ > 0) MiniFloatConverter::reduceMantissaToNbitsRounding(bits_, data.begin(), data.end(), data.begin()); }
+        inline void bulk(boost::sub_range<std::vector<float>> data) const { if (bits_ > 0 && !data.empty()) MiniFloatConverter::reduceMantissaToNbitsRounding(&data.front(), &data.front(), data.size(), bits_); }
     };
 }
 
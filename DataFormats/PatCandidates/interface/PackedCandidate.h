@@ -19,6 +19,8 @@
 class testPackedCandidate;
 
 namespace pat {
+  struct PackedCandidateColumns;
+
   class PackedCandidate : public reco::Candidate {
   public:
     /// collection of daughter candidates                                                 
@@ -690,6 +692,7 @@ namespace pat {
 
   protected:
     friend class ::testPackedCandidate;
+    friend struct PackedCandidateColumns;
     static constexpr float kMinDEtaToStore_=0.001;
     static constexpr float kMinDTrkPtToStore_=0.001;
     
@@ -0,0 +1,56 @@
+#ifndef __DataFormats_PatCandidates_PackedCandidateColumns_h__
+#define __DataFormats_PatCandidates_PackedCandidateColumns_h__
+
+#include <vector>
+
+namespace pat {
+
+  class PackedCandidate;
+
+  /** The kinematics of a collection of PackedCandidates, decoded in one pass
+   *  and stored column by column.
+   *
+   *  Reading pt(), eta(), vertex()... of each PackedCandidate unpacks it
+   *  on first access, allocating its cached four vectors and vertex. When
+   *  the whole collection is needed, fill() decodes the packed values of
+   *  all the candidates directly into these columns instead, without
+   *  touching the caches of the candidates. The values are identical to
+   *  those returned by the PackedCandidate accessors, in float precision.
+   *
+   *  \code
+   *    pat::PackedCandidateColumns columns;
+   *    columns.fill(*candidates, pat::PackedCandidateColumns::kVertex);
+   *    for (unsigned int i = 0; i < columns.size(); ++i) { ... columns.pt[i] ... columns.dz[i] ... }
+   *  \endcode
+   */
+  struct PackedCandidateColumns {
+    /// what is decoded in addition to the four momentum
+    enum Content { kP4 = 0, kVertex = 1, kCovariance = 2 };
+
+    /// decodes the candidates, replacing the current content. 'content' is
+    /// a combination of Content flags; the covariance columns are filled
+    /// for the candidates with hasTrackDetails(), and are 0 for the others
+    void fill(std::vector<PackedCandidate> const& candidates, unsigned int content = kVertex);
+
+    unsigned int size() const { return pt.size(); }
+
+    void clear();
+
+    /// four momentum, as polarP4() and p4()
+    std::vector<float> pt, eta, phi, mass;
+    std::vector<float> px, py, pz, energy;
+
+    /// vertex(), dxy() and dzAssociatedPV(), filled with kVertex
+    std::vector<float> vx, vy, vz;
+    std::vector<float> dxy, dz;
+
+    /// the non-zero elements of the track covariance matrix, as
+    /// pseudoTrack().covariance(i,j), filled with kCovariance
+    std::vector<float> dptdpt, detadeta, dphidphi;
+    std::vector<float> dxydxy, dzdz, dxydz;
+    std::vector<float> dlambdadz, dphidxy;
+  };
+
+}
+
+#endif
@@ -1,4 +1,5 @@
 #include "DataFormats/PatCandidates/interface/PackedCandidate.h"
+#include "DataFormats/PatCandidates/interface/PackedCandidateColumns.h"
 #include "DataFormats/SiPixelDetId/interface/PixelSubdetector.h"
 #include "DataFormats/SiStripDetId/interface/StripSubdetector.h"
 #include "DataFormats/Math/interface/libminifloat.h"
@@ -10,6 +11,33 @@ using namespace logintpack;
 CovarianceParameterization pat::PackedCandidate::covarianceParameterization_;
 std::once_flag pat::PackedCandidate::covariance_load_flag;
 
+namespace {
+    // decoding of the packed values, shared by unpack(), unpackVtx() and PackedCandidateColumns::fill()
+    inline float unpackEta(uint16_t packedEta) {
+        return int16_t(packedEta)*6.0f/std::numeric_limits<int16_t>::max();
+    }
+    inline double unpackPhi(uint16_t packedPhi, float pt) {
+        double shift = (pt<1. ? 0.1*pt : 0.1/pt); // shift particle phi to break degeneracies in angular separations
+        double sign = ( ( int(pt*10) % 2 == 0 ) ? 1 : -1 ); // introduce a pseudo-random sign of the shift
+        return int16_t(packedPhi)*3.2f/std::numeric_limits<int16_t>::max() + sign*shift*3.2/std::numeric_limits<int16_t>::max();
+    }
+    inline float unpackDPhi(uint16_t packedDPhi) {
+        return int16_t(packedDPhi)*3.2f/std::numeric_limits<int16_t>::max();
+    }
+    inline float unpackDxy(uint16_t packedDxy) {
+        return MiniFloatConverter::float16to32(packedDxy)/100.;
+    }
+    inline float unpackDz(uint16_t packedDz, bool hasPV) {
+        return hasPV ? MiniFloatConverter::float16to32(packedDz)/100. : int16_t(packedDz)*40.f/std::numeric_limits<int16_t>::max();
+    }
+    inline pat::PackedCandidate::Point unpackVertex(const pat::PackedCandidate::Point &pv, double p4Phi, float dphi, float dxy, float dz) {
+        float phi = p4Phi+dphi, s = std::sin(phi), c = std::cos(phi);
+        return pat::PackedCandidate::Point(pv.X() - dxy * s,
+                                           pv.Y() + dxy * c,
+                                           pv.Z() + dz ); // for our choice of using the PCA to the PV, by definition the remaining term -(dx*cos(phi) + dy*sin(phi))*(pz/pt) is zero
+    }
+}
+
 void pat::PackedCandidate::pack(bool unpackAfterwards) {
     packedPt_  =  MiniFloatConverter::float32to16(p4_.load()->Pt());
     packedEta_ =  int16_t(std::round(p4_.load()->Eta()/6.0f*std::numeric_limits<int16_t>::max()));
@@ -47,12 +75,9 @@ void pat::PackedCandidate::packVtx(bool unpackAfterwards) {
 
 void pat::PackedCandidate::unpack() const {
     float pt = MiniFloatConverter::float16to32(packedPt_);
-    double shift = (pt<1. ? 0.1*pt : 0.1/pt); // shift particle phi to break degeneracies in angular separations
-    double sign = ( ( int(pt*10) % 2 == 0 ) ? 1 : -1 ); // introduce a pseudo-random sign of the shift
-    double phi = int16_t(packedPhi_)*3.2f/std::numeric_limits<int16_t>::max() + sign*shift*3.2/std::numeric_limits<int16_t>::max();
     auto p4 = std::make_unique<PolarLorentzVector>(pt,
-                             int16_t(packedEta_)*6.0f/std::numeric_limits<int16_t>::max(),
-                             phi,
+                             unpackEta(packedEta_),
+                             unpackPhi(packedPhi_, pt),
                              MiniFloatConverter::float16to32(packedM_));
     auto p4c = std::make_unique<LorentzVector>( *p4 );
     PolarLorentzVector* expectp4= nullptr;
@@ -113,20 +138,14 @@ void pat::PackedCandidate::unpackCovariance() const {
 
 void pat::PackedCandidate::unpackVtx() const {
     reco::VertexRef pvRef = vertexRef();
-    dphi_ = int16_t(packedDPhi_)*3.2f/std::numeric_limits<int16_t>::max(),
+    dphi_ = unpackDPhi(packedDPhi_);
     deta_ = MiniFloatConverter::float16to32(packedDEta_);
     dtrkpt_ = MiniFloatConverter::float16to32(packedDTrkPt_);
-    dxy_ = MiniFloatConverter::float16to32(packedDxy_)/100.;
-    dz_   = pvRef.isNonnull() ? MiniFloatConverter::float16to32(packedDz_)/100. : int16_t(packedDz_)*40.f/std::numeric_limits<int16_t>::max();
+    dxy_ = unpackDxy(packedDxy_);
+    dz_   = unpackDz(packedDz_, pvRef.isNonnull());
     Point pv = pvRef.isNonnull() ? pvRef->position() : Point();
-    float phi = p4_.load()->Phi()+dphi_, s = std::sin(phi), c = std::cos(phi);
-    auto vertex = std::make_unique<Point>(pv.X() - dxy_ * s,
-                    pv.Y() + dxy_ * c,
-                    pv.Z() + dz_ ); // for our choice of using the PCA to the PV, by definition the remaining term -(dx*cos(phi) + dy*sin(phi))*(pz/pt) is zero
+    auto vertex = std::make_unique<Point>(unpackVertex(pv, p4_.load()->Phi(), dphi_, dxy_, dz_));
 
-     
-
- 
     Point* expected = nullptr;
     if( vertex_.compare_exchange_strong(expected,vertex.get()) ) {
       vertex.release();
@@ -442,3 +461,99 @@ int16_t pat::PackedCandidate::packTimeWithError(float   time, float   timeError)
     }
 }
 
+
+void pat::PackedCandidateColumns::clear() {
+    for (auto* column : {&pt, &eta, &phi, &mass, &px, &py, &pz, &energy, &vx, &vy, &vz, &dxy, &dz,
+                         &dptdpt, &detadeta, &dphidphi, &dxydxy, &dzdz, &dxydz, &dlambdadz, &dphidxy}) {
+        column->clear();
+    }
+}
+
+void pat::PackedCandidateColumns::fill(const std::vector<PackedCandidate> &candidates, unsigned int content) {
+    clear();
+    const unsigned int n = candidates.size();
+    for (auto* column : {&pt, &eta, &phi, &mass, &px, &py, &pz, &energy}) {
+        column->resize(n);
+    }
+
+    // the same decoding as PackedCandidate::unpack(), without the cache allocations
+    std::vector<uint16_t> packedPt(n), packedM(n);
+    for (unsigned int i = 0; i < n; ++i) {
+        packedPt[i] = candidates[i].packedPt_;
+        packedM[i] = candidates[i].packedM_;
+    }
+    MiniFloatConverter::float16to32(packedPt.data(), pt.data(), n);
+    MiniFloatConverter::float16to32(packedM.data(), mass.data(), n);
+    // unpackVtx() uses phi in double precision
+    std::vector<double> p4Phi((content & kVertex) ? n : 0);
+    for (unsigned int i = 0; i < n; ++i) {
+        const PackedCandidate &cand = candidates[i];
+        const PackedCandidate::PolarLorentzVector p4(pt[i], unpackEta(cand.packedEta_), unpackPhi(cand.packedPhi_, pt[i]), mass[i]);
+        const PackedCandidate::LorentzVector p4c(p4);
+        eta[i] = p4.Eta();
+        phi[i] = p4.Phi();
+        if (content & kVertex) {
+            p4Phi[i] = p4.Phi();
+        }
+        px[i] = p4c.Px();
+        py[i] = p4c.Py();
+        pz[i] = p4c.Pz();
+        energy[i] = p4c.E();
+    }
+
+    if (content & kVertex) {
+        for (auto* column : {&vx, &vy, &vz, &dxy, &dz}) {
+            column->resize(n);
+        }
+        // as PackedCandidate::unpackVtx(); the candidates usually share a few primary vertices
+        reco::VertexRef lastPV;
+        PackedCandidate::Point pv;
+        for (unsigned int i = 0; i < n; ++i) {
+            const PackedCandidate &cand = candidates[i];
+            reco::VertexRef pvRef = cand.vertexRef();
+            const bool hasPV = pvRef.isNonnull();
+            if (pvRef != lastPV) {
+                pv = hasPV ? pvRef->position() : PackedCandidate::Point();
+                lastPV = pvRef;
+            }
+            dxy[i] = unpackDxy(cand.packedDxy_);
+            dz[i] = unpackDz(cand.packedDz_, hasPV);
+            const PackedCandidate::Point vertex = unpackVertex(pv, p4Phi[i], unpackDPhi(cand.packedDPhi_), dxy[i], dz[i]);
+            vx[i] = vertex.X();
+            vy[i] = vertex.Y();
+            vz[i] = vertex.Z();
+        }
+    }
+
+    if (content & kCovariance) {
+        for (auto* column : {&dptdpt, &detadeta, &dphidphi, &dxydxy, &dzdz, &dxydz, &dlambdadz, &dphidxy}) {
+            column->assign(n, 0.f);
+        }
+        // as PackedCandidate::unpackCovariance()
+        for (unsigned int i = 0; i < n; ++i) {
+            const PackedCandidate &cand = candidates[i];
+            if (!cand.hasTrackDetails()) {
+                continue;
+            }
+            const CovarianceParameterization &p = cand.covarianceParameterization();
+            if (!p.isValid()) {
+                throw edm::Exception(edm::errors::UnimplementedFeature)
+                    << "You do not have a valid track parameters file loaded. "
+                    << "Please check that the release version is compatible with your input data"
+                    << "or avoid accessing track parameter uncertainties. ";
+            }
+            const PackedCandidate::PackedCovariance &packed = cand.packedCovariance_;
+            const int schema = cand.covarianceSchema_;
+            const int nHits = cand.numberOfHits(), nPixelHits = cand.numberOfPixelHits();
+            const float candPt = pt[i], candEta = eta[i];
+            dptdpt[i] = p.unpack(packed.dptdpt, schema, 0, 0, candPt, candEta, nHits, nPixelHits);
+            detadeta[i] = p.unpack(packed.detadeta, schema, 1, 1, candPt, candEta, nHits, nPixelHits);
+            dphidphi[i] = p.unpack(packed.dphidphi, schema, 2, 2, candPt, candEta, nHits, nPixelHits);
+            dxydxy[i] = p.unpack(packed.dxydxy, schema, 3, 3, candPt, candEta, nHits, nPixelHits);
+            dzdz[i] = p.unpack(packed.dzdz, schema, 4, 4, candPt, candEta, nHits, nPixelHits);
+            dxydz[i] = p.unpack(packed.dxydz, schema, 3, 4, candPt, candEta, nHits, nPixelHits);
+            dlambdadz[i] = p.unpack(packed.dlambdadz, schema, 1, 4, candPt, candEta, nHits, nPixelHits);
+            dphidxy[i] = p.unpack(packed.dphidxy, schema, 2, 3, candPt, candEta, nHits, nPixelHits);
+        }
+    }
+}
@@ -5,6 +5,7 @@
 #include <iomanip>
 
 #include "DataFormats/PatCandidates/interface/PackedCandidate.h"
+#include "DataFormats/PatCandidates/interface/PackedCandidateColumns.h"
 
 class testPackedCandidate : public CppUnit::TestFixture {
   CPPUNIT_TEST_SUITE(testPackedCandidate);
@@ -15,6 +16,7 @@ class testPackedCandidate : public CppUnit::TestFixture {
   CPPUNIT_TEST(testSimulateReadFromRoot);
   CPPUNIT_TEST(testPackUnpackTime);
   CPPUNIT_TEST(testQualityFlags);
+  CPPUNIT_TEST(testColumns);
 
   CPPUNIT_TEST_SUITE_END();
 public:
@@ -28,6 +30,7 @@ public:
 
   void testPackUnpackTime();
   void testQualityFlags();
+  void testColumns();
 
 private:
 };
@@ -318,3 +321,82 @@ void testPackedCandidate::testQualityFlags() {
 	      
 	      
 	    
+
+void testPackedCandidate::testColumns() {
+  std::vector<pat::PackedCandidate> candidates;
+  for (int i = 0; i < 100; ++i) {
+    pat::PackedCandidate::PolarLorentzVector plv(0.3 + 0.7*i, -4.5 + 0.09*i, -3.1 + 0.062*i, (i % 3) * 0.1396);
+    pat::PackedCandidate::Point v(0.001*i, -0.002*i, 0.3*i - 15.);
+    candidates.emplace_back(plv, v, plv.Pt()*1.01, plv.Eta(), plv.Phi(), 211, reco::VertexRefProd(), reco::VertexRef().key());
+  }
+  //the columns are decoded from the packed values, the accessors use the values unpacked by the constructor
+  pat::PackedCandidateColumns columns;
+  columns.fill(candidates, pat::PackedCandidateColumns::kVertex);
+  CPPUNIT_ASSERT(columns.size() == candidates.size());
+  for (unsigned int i = 0; i < columns.size(); ++i) {
+    auto const& c = candidates[i];
+    CPPUNIT_ASSERT(columns.pt[i] == float(c.pt()));
+    CPPUNIT_ASSERT(columns.eta[i] == float(c.eta()));
+    CPPUNIT_ASSERT(columns.phi[i] == float(c.phi()));
+    CPPUNIT_ASSERT(columns.mass[i] == float(c.mass()));
+    CPPUNIT_ASSERT(columns.px[i] == float(c.px()));
+    CPPUNIT_ASSERT(columns.py[i] == float(c.py()));
+    CPPUNIT_ASSERT(columns.pz[i] == float(c.pz()));
+    CPPUNIT_ASSERT(columns.energy[i] == float(c.energy()));
+    CPPUNIT_ASSERT(columns.vx[i] == float(c.vx()));
+    CPPUNIT_ASSERT(columns.vy[i] == float(c.vy()));
+    CPPUNIT_ASSERT(columns.vz[i] == float(c.vz()));
+    CPPUNIT_ASSERT(columns.dxy[i] == c.dxy());
+    CPPUNIT_ASSERT(columns.dz[i] == c.dzAssociatedPV());
+  }
+  CPPUNIT_ASSERT(columns.dxydxy.empty());
+
+  columns.fill(candidates, pat::PackedCandidateColumns::kP4);
+  CPPUNIT_ASSERT(columns.pt.size() == candidates.size());
+  CPPUNIT_ASSERT(columns.vx.empty());
+
+  //every other candidate gets track details, with each of the packing schemas of packedPFCandidates
+  //and different numbers of pixel and strip hits, on which the packing depends
+  const int schemas[] = {8, 264, 520, 776};
+  for (unsigned int i = 0; i < candidates.size(); i += 2) {
+    reco::TrackBase::CovarianceMatrix cov;
+    const double scale = 1. + 0.02*i;
+    const double diagonal[] = {1e-4, 2e-6, 3e-6, 4e-4, 5e-4};
+    for (int j = 0; j < 5; ++j) {
+      cov(j,j) = diagonal[j]*scale;
+    }
+    cov(3,4) = 1e-4*scale;
+    cov(1,4) = -1e-6*scale;
+    cov(2,3) = 5e-7*scale;
+    auto const& c = candidates[i];
+    reco::Track tk(1.5, 10, c.vertex(), c.momentum(), c.charge(), cov, reco::TrackBase::initialStep);
+    //valid hits in the pixel barrel (substructure 1), then in the TIB and TOB (3 and 5)
+    for (unsigned int layer = 1; layer <= 1 + i % 4; ++layer) {
+      tk.appendHitPattern((1 << 10) | (1 << 7) | (layer << 3), TrackingRecHit::valid);
+    }
+    for (unsigned int layer = 1; layer <= 4 + i % 7; ++layer) {
+      tk.appendHitPattern((1 << 10) | ((layer <= 4 ? 3 : 5) << 7) | ((layer <= 4 ? layer : layer - 4) << 3), TrackingRecHit::valid);
+    }
+    candidates[i].setTrackProperties(tk, schemas[(i/2) % 4], 0);
+  }
+  columns.fill(candidates, pat::PackedCandidateColumns::kCovariance);
+  CPPUNIT_ASSERT(columns.dxydxy.size() == candidates.size());
+  CPPUNIT_ASSERT(columns.vx.empty());
+  for (unsigned int i = 0; i < columns.size(); ++i) {
+    auto const& c = candidates[i];
+    if (!c.hasTrackDetails()) {
+      CPPUNIT_ASSERT(columns.dptdpt[i] == 0.f && columns.dzdz[i] == 0.f && columns.dphidxy[i] == 0.f);
+      continue;
+    }
+    auto const& tk = c.pseudoTrack();
+    CPPUNIT_ASSERT(columns.dptdpt[i] == float(tk.covariance(0,0)));
+    CPPUNIT_ASSERT(columns.detadeta[i] == float(tk.covariance(1,1)));
+    CPPUNIT_ASSERT(columns.dphidphi[i] == float(tk.covariance(2,2)));
+    CPPUNIT_ASSERT(columns.dxydxy[i] == float(tk.covariance(3,3)));
+    CPPUNIT_ASSERT(columns.dzdz[i] == float(tk.covariance(4,4)));
+    CPPUNIT_ASSERT(columns.dxydz[i] == float(tk.covariance(3,4)));
+    CPPUNIT_ASSERT(columns.dlambdadz[i] == float(tk.covariance(1,4)));
+    CPPUNIT_ASSERT(columns.dphidxy[i] == float(tk.covariance(2,3)));
+    CPPUNIT_ASSERT(columns.dxydxy[i] != 0.f);
+  }
+}
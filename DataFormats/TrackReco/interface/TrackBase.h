@@ -354,6 +354,9 @@ public:
     /// Sets HitPattern as empty
     void resetHitPattern();
 
+    /// Replaces the HitPattern, e.g. when the track is rebuilt from a TrackSoA
+    void setHitPattern(const HitPattern &hitPattern) { hitPattern_ = hitPattern; }
+
     ///Track algorithm
     void setAlgorithm(const TrackAlgorithm a);
    
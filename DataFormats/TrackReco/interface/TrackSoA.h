@@ -0,0 +1,184 @@
+#ifndef TrackReco_TrackSoA_h
+#define TrackReco_TrackSoA_h
+/** \class reco::TrackSoA TrackSoA.h DataFormats/TrackReco/interface/TrackSoA.h
+ *
+ * The fit parameters of a collection of tracks stored column by column
+ * ('structure of arrays'), for the algorithms which loop over many tracks
+ * but only use a few of their parameters (selectors, vertexing, PF).
+ *
+ * The columns are edm::soa::Column types declared in the reco::trackcol
+ * namespace. A function taking an edm::soa::TableView of the columns it
+ * needs runs either on a TrackSoA
+ * \code
+ *   reco::TrackSoA const& tracks = ...;
+ *   auto view = tracks.view<reco::trackcol::Pt, reco::trackcol::Dz>();
+ *   for (auto const& row : view) { ... row.get<reco::trackcol::Pt>() ... }
+ * \endcode
+ * or on an edm::soa::Table filled directly from a reco::TrackCollection
+ * with any subset of the columns
+ * \code
+ *   edm::soa::Table<reco::trackcol::Pt, reco::trackcol::Dz> table{trackCollection};
+ * \endcode
+ *
+ * The TrackSoA itself keeps one std::vector per column, so that it can be
+ * written with ROOT. The momentum is kept as pt, eta and phi and the
+ * reference point in single precision, like the covariance matrix. The
+ * reference to the TrackExtra, the number of loops and the stop reason are
+ * not kept: track(i) rebuilds a reco::Track without them.
+ *
+ */
+#include "DataFormats/TrackReco/interface/HitPattern.h"
+#include "DataFormats/TrackReco/interface/Track.h"
+#include "DataFormats/TrackReco/interface/TrackFwd.h"
+#include "FWCore/SOA/interface/Column.h"
+#include "FWCore/SOA/interface/TableView.h"
+
+#include <array>
+#include <cstdint>
+#include <vector>
+
+namespace reco
+{
+
+/// the 15 independent elements of the covariance matrix of a track, in the
+/// order of TrackBase::covIndex
+struct TrackCovarianceBlock
+{
+    float elements[TrackBase::covarianceSize];
+};
+
+namespace trackcol
+{
+    SOA_DECLARE_COLUMN(Pt, float, "pt");
+    SOA_DECLARE_COLUMN(Eta, float, "eta");
+    SOA_DECLARE_COLUMN(Phi, float, "phi");
+    SOA_DECLARE_COLUMN(Charge, int, "charge");
+    SOA_DECLARE_COLUMN(Dxy, float, "dxy");
+    SOA_DECLARE_COLUMN(Dz, float, "dz");
+    SOA_DECLARE_COLUMN(Vx, float, "vx");
+    SOA_DECLARE_COLUMN(Vy, float, "vy");
+    SOA_DECLARE_COLUMN(Vz, float, "vz");
+    SOA_DECLARE_COLUMN(Chi2, float, "chi2");
+    SOA_DECLARE_COLUMN(Ndof, float, "ndof");
+    SOA_DECLARE_COLUMN(Algo, uint8_t, "algo");
+    SOA_DECLARE_COLUMN(OriginalAlgo, uint8_t, "originalAlgo");
+    SOA_DECLARE_COLUMN(AlgoMask, unsigned long long, "algoMask");
+    SOA_DECLARE_COLUMN(QualityMask, uint8_t, "qualityMask");
+    SOA_DECLARE_COLUMN(Covariance, TrackCovarianceBlock, "covariance");
+    SOA_DECLARE_COLUMN(Hits, HitPattern, "hitPattern");
+
+    // used by edm::soa::Table to fill the columns from reco::Tracks
+    inline float value_for_column(TrackBase const& t, Pt*) { return t.pt(); }
+    inline float value_for_column(TrackBase const& t, Eta*) { return t.eta(); }
+    inline float value_for_column(TrackBase const& t, Phi*) { return t.phi(); }
+    inline int value_for_column(TrackBase const& t, Charge*) { return t.charge(); }
+    inline float value_for_column(TrackBase const& t, Dxy*) { return t.dxy(); }
+    inline float value_for_column(TrackBase const& t, Dz*) { return t.dz(); }
+    inline float value_for_column(TrackBase const& t, Vx*) { return t.vx(); }
+    inline float value_for_column(TrackBase const& t, Vy*) { return t.vy(); }
+    inline float value_for_column(TrackBase const& t, Vz*) { return t.vz(); }
+    inline float value_for_column(TrackBase const& t, Chi2*) { return t.chi2(); }
+    inline float value_for_column(TrackBase const& t, Ndof*) { return t.ndof(); }
+    inline uint8_t value_for_column(TrackBase const& t, Algo*) { return t.algo(); }
+    inline uint8_t value_for_column(TrackBase const& t, OriginalAlgo*) { return t.originalAlgo(); }
+    inline unsigned long long value_for_column(TrackBase const& t, AlgoMask*) { return t.algoMaskUL(); }
+    inline uint8_t value_for_column(TrackBase const& t, QualityMask*) { return t.qualityMask(); }
+    TrackCovarianceBlock value_for_column(TrackBase const& t, Covariance*);
+    inline HitPattern value_for_column(TrackBase const& t, Hits*) { return t.hitPattern(); }
+} // namespace trackcol
+
+class TrackSoA
+{
+
+public:
+    TrackSoA() {}
+
+    /// converts a collection of tracks
+    explicit TrackSoA(const TrackCollection &tracks);
+
+    unsigned int size() const {
+        return pt_.size();
+    }
+
+    bool empty() const {
+        return pt_.empty();
+    }
+
+    void reserve(unsigned int n);
+
+    void clear();
+
+    /// appends the parameters of a track
+    void push_back(const TrackBase &track);
+
+    /// the values of one column, e.g. column<trackcol::Pt>()
+    template <typename C>
+    edm::soa::ColumnValues<typename C::type> column() const {
+        return edm::soa::ColumnValues<typename C::type>(
+            static_cast<typename C::type const *>(columnAddress(static_cast<C const *>(nullptr))), size());
+    }
+
+    /// the value of one column for the i-th track, e.g. get<trackcol::Pt>(i)
+    template <typename C>
+    const typename C::type &get(unsigned int i) const {
+        return static_cast<typename C::type const *>(columnAddress(static_cast<C const *>(nullptr)))[i];
+    }
+
+    /// a view of some of the columns, to be passed to functions taking an
+    /// edm::soa::TableView
+    template <typename... C>
+    edm::soa::TableView<C...> view() const {
+        std::array<void const *, sizeof...(C)> columns{{columnAddress(static_cast<C const *>(nullptr))...}};
+        return edm::soa::TableView<C...>(size(), columns);
+    }
+
+    /// covariance matrix of the i-th track
+    TrackBase::CovarianceMatrix covariance(unsigned int i) const;
+
+    /// rebuilds the i-th track
+    Track track(unsigned int i) const;
+
+    /// rebuilds all the tracks
+    TrackCollection tracks() const;
+
+private:
+    void const *columnAddress(trackcol::Pt const *) const { return pt_.data(); }
+    void const *columnAddress(trackcol::Eta const *) const { return eta_.data(); }
+    void const *columnAddress(trackcol::Phi const *) const { return phi_.data(); }
+    void const *columnAddress(trackcol::Charge const *) const { return charge_.data(); }
+    void const *columnAddress(trackcol::Dxy const *) const { return dxy_.data(); }
+    void const *columnAddress(trackcol::Dz const *) const { return dz_.data(); }
+    void const *columnAddress(trackcol::Vx const *) const { return vx_.data(); }
+    void const *columnAddress(trackcol::Vy const *) const { return vy_.data(); }
+    void const *columnAddress(trackcol::Vz const *) const { return vz_.data(); }
+    void const *columnAddress(trackcol::Chi2 const *) const { return chi2_.data(); }
+    void const *columnAddress(trackcol::Ndof const *) const { return ndof_.data(); }
+    void const *columnAddress(trackcol::Algo const *) const { return algorithm_.data(); }
+    void const *columnAddress(trackcol::OriginalAlgo const *) const { return originalAlgorithm_.data(); }
+    void const *columnAddress(trackcol::AlgoMask const *) const { return algoMask_.data(); }
+    void const *columnAddress(trackcol::QualityMask const *) const { return quality_.data(); }
+    void const *columnAddress(trackcol::Covariance const *) const { return covariance_.data(); }
+    void const *columnAddress(trackcol::Hits const *) const { return hitPattern_.data(); }
+
+    std::vector<float> pt_;
+    std::vector<float> eta_;
+    std::vector<float> phi_;
+    std::vector<int> charge_;
+    std::vector<float> dxy_;
+    std::vector<float> dz_;
+    std::vector<float> vx_;
+    std::vector<float> vy_;
+    std::vector<float> vz_;
+    std::vector<float> chi2_;
+    std::vector<float> ndof_;
+    std::vector<uint8_t> algorithm_;
+    std::vector<uint8_t> originalAlgorithm_;
+    std::vector<unsigned long long> algoMask_;
+    std::vector<uint8_t> quality_;
+    std::vector<TrackCovarianceBlock> covariance_;
+    std::vector<HitPattern> hitPattern_;
+};
+
+} // namespace reco
+
+#endif
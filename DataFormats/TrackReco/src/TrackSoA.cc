@@ -0,0 +1,121 @@
+#include "DataFormats/TrackReco/interface/TrackSoA.h"
+#include "DataFormats/TrackReco/interface/fillCovariance.h"
+
+#include <cmath>
+
+using namespace reco;
+
+TrackCovarianceBlock trackcol::value_for_column(TrackBase const& t, Covariance*)
+{
+    TrackCovarianceBlock block;
+    for (int i = 0; i < TrackBase::dimension; ++i) {
+        for (int j = 0; j <= i; ++j) {
+            block.elements[TrackBase::covIndex(i, j)] = t.covariance(i, j);
+        }
+    }
+    return block;
+}
+
+TrackSoA::TrackSoA(const TrackCollection &tracks)
+{
+    reserve(tracks.size());
+    for (auto const& track : tracks) {
+        push_back(track);
+    }
+}
+
+void TrackSoA::reserve(unsigned int n)
+{
+    pt_.reserve(n);
+    eta_.reserve(n);
+    phi_.reserve(n);
+    charge_.reserve(n);
+    dxy_.reserve(n);
+    dz_.reserve(n);
+    vx_.reserve(n);
+    vy_.reserve(n);
+    vz_.reserve(n);
+    chi2_.reserve(n);
+    ndof_.reserve(n);
+    algorithm_.reserve(n);
+    originalAlgorithm_.reserve(n);
+    algoMask_.reserve(n);
+    quality_.reserve(n);
+    covariance_.reserve(n);
+    hitPattern_.reserve(n);
+}
+
+void TrackSoA::clear()
+{
+    pt_.clear();
+    eta_.clear();
+    phi_.clear();
+    charge_.clear();
+    dxy_.clear();
+    dz_.clear();
+    vx_.clear();
+    vy_.clear();
+    vz_.clear();
+    chi2_.clear();
+    ndof_.clear();
+    algorithm_.clear();
+    originalAlgorithm_.clear();
+    algoMask_.clear();
+    quality_.clear();
+    covariance_.clear();
+    hitPattern_.clear();
+}
+
+void TrackSoA::push_back(const TrackBase &track)
+{
+    using namespace trackcol;
+    pt_.push_back(value_for_column(track, static_cast<Pt*>(nullptr)));
+    eta_.push_back(value_for_column(track, static_cast<Eta*>(nullptr)));
+    phi_.push_back(value_for_column(track, static_cast<Phi*>(nullptr)));
+    charge_.push_back(value_for_column(track, static_cast<Charge*>(nullptr)));
+    dxy_.push_back(value_for_column(track, static_cast<Dxy*>(nullptr)));
+    dz_.push_back(value_for_column(track, static_cast<Dz*>(nullptr)));
+    vx_.push_back(value_for_column(track, static_cast<Vx*>(nullptr)));
+    vy_.push_back(value_for_column(track, static_cast<Vy*>(nullptr)));
+    vz_.push_back(value_for_column(track, static_cast<Vz*>(nullptr)));
+    chi2_.push_back(value_for_column(track, static_cast<Chi2*>(nullptr)));
+    ndof_.push_back(value_for_column(track, static_cast<Ndof*>(nullptr)));
+    algorithm_.push_back(value_for_column(track, static_cast<Algo*>(nullptr)));
+    originalAlgorithm_.push_back(value_for_column(track, static_cast<OriginalAlgo*>(nullptr)));
+    algoMask_.push_back(value_for_column(track, static_cast<AlgoMask*>(nullptr)));
+    quality_.push_back(value_for_column(track, static_cast<QualityMask*>(nullptr)));
+    covariance_.push_back(value_for_column(track, static_cast<Covariance*>(nullptr)));
+    hitPattern_.push_back(value_for_column(track, static_cast<Hits*>(nullptr)));
+}
+
+TrackBase::CovarianceMatrix TrackSoA::covariance(unsigned int i) const
+{
+    TrackBase::CovarianceMatrix m;
+    fillCovariance(m, covariance_[i].elements);
+    return m;
+}
+
+Track TrackSoA::track(unsigned int i) const
+{
+    const double pt = pt_[i];
+    const TrackBase::Vector momentum(pt * std::cos(phi_[i]), pt * std::sin(phi_[i]), pt * std::sinh(eta_[i]));
+    const TrackBase::Point vertex(vx_[i], vy_[i], vz_[i]);
+
+    Track track(chi2_[i], ndof_[i], vertex, momentum, charge_[i], covariance(i),
+                TrackBase::TrackAlgorithm(algorithm_[i]));
+    track.setOriginalAlgorithm(TrackBase::TrackAlgorithm(originalAlgorithm_[i]));
+    track.setAlgoMask(TrackBase::AlgoMask(algoMask_[i]));
+    track.setQualityMask(quality_[i]);
+    track.setHitPattern(hitPattern_[i]);
+    return track;
+}
+
+TrackCollection TrackSoA::tracks() const
+{
+    TrackCollection tracks;
+    tracks.reserve(size());
+    for (unsigned int i = 0; i < size(); ++i) {
+        tracks.push_back(track(i));
+    }
+    return tracks;
+}
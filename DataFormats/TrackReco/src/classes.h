@@ -5,6 +5,7 @@
 #include "Math/CylindricalEta3D.h" 
 #include "DataFormats/TrackReco/interface/Track.h"
 #include "DataFormats/TrackReco/interface/TrackFwd.h" 
+#include "DataFormats/TrackReco/interface/TrackSoA.h"
 #include "DataFormats/TrackReco/interface/TrackExtra.h"
 #include "DataFormats/TrackReco/interface/TrackExtraFwd.h" 
 #include "DataFormats/TrackReco/interface/TrackResiduals.h"
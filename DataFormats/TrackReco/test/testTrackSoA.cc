@@ -0,0 +1,121 @@
+#include <cppunit/extensions/HelperMacros.h>
+#include "DataFormats/TrackReco/interface/Track.h"
+#include "DataFormats/TrackReco/interface/TrackSoA.h"
+#include "FWCore/SOA/interface/Table.h"
+
+class testTrackSoA : public CppUnit::TestFixture {
+    CPPUNIT_TEST_SUITE(testTrackSoA);
+    CPPUNIT_TEST(checkColumns);
+    CPPUNIT_TEST(checkRoundTrip);
+    CPPUNIT_TEST(checkTable);
+    CPPUNIT_TEST_SUITE_END();
+
+public:
+    void setUp();
+    void tearDown() {}
+    void checkColumns();
+    void checkRoundTrip();
+    void checkTable();
+
+private:
+    reco::TrackCollection tracks_;
+};
+
+CPPUNIT_TEST_SUITE_REGISTRATION(testTrackSoA);
+
+void testTrackSoA::setUp() {
+    double e[] = { 1.1,
+         1.2, 2.2,
+         1.3, 2.3, 3.3,
+         1.4, 2.4, 3.4, 4.4,
+         1.5, 2.5, 3.5, 4.5, 5.5
+    };
+    reco::TrackBase::CovarianceMatrix cov(e, e + 15);
+
+    tracks_.clear();
+    for (int i = 0; i < 50; ++i) {
+        reco::Track::Point v(0.01 * i, -0.02 * i, 0.5 * i - 10);
+        reco::Track::Vector p(1.5 + i, 0.3 * i - 4, 2. - 0.1 * i);
+        reco::Track t(10. + i, 5 + i % 3, v, p, i % 2 ? +1 : -1, cov, reco::TrackBase::initialStep);
+        t.setOriginalAlgorithm(reco::TrackBase::lowPtTripletStep);
+        if (i % 3 == 0) {
+            t.setQuality(reco::TrackBase::highPurity);
+        }
+        t.appendHitPattern(0x4a8, TrackingRecHit::valid);
+        t.appendHitPattern(0x4b1, TrackingRecHit::missing);
+        tracks_.push_back(t);
+    }
+}
+
+void testTrackSoA::checkColumns() {
+    using namespace reco::trackcol;
+    reco::TrackSoA soa(tracks_);
+    CPPUNIT_ASSERT(soa.size() == tracks_.size());
+
+    unsigned int i = 0;
+    for (auto pt : soa.column<Pt>()) {
+        CPPUNIT_ASSERT_DOUBLES_EQUAL(tracks_[i].pt(), pt, 1e-5 * pt);
+        ++i;
+    }
+    CPPUNIT_ASSERT(i == tracks_.size());
+
+    i = 0;
+    for (auto const& row : soa.view<Dz, Eta, Charge>()) {
+        CPPUNIT_ASSERT_DOUBLES_EQUAL(tracks_[i].dz(), row.get<Dz>(), 1e-5);
+        CPPUNIT_ASSERT_DOUBLES_EQUAL(tracks_[i].eta(), row.get<Eta>(), 1e-5);
+        CPPUNIT_ASSERT(tracks_[i].charge() == row.get<Charge>());
+        ++i;
+    }
+    CPPUNIT_ASSERT(i == tracks_.size());
+
+    for (i = 0; i < soa.size(); ++i) {
+        CPPUNIT_ASSERT_DOUBLES_EQUAL(tracks_[i].dxy(), soa.get<Dxy>(i), 1e-5);
+        CPPUNIT_ASSERT(soa.get<QualityMask>(i) == tracks_[i].qualityMask());
+        CPPUNIT_ASSERT(soa.get<Hits>(i).numberOfAllHits(reco::HitPattern::TRACK_HITS) == 2);
+        CPPUNIT_ASSERT_DOUBLES_EQUAL(tracks_[i].covariance(3, 1), soa.covariance(i)(3, 1), 1e-6);
+        CPPUNIT_ASSERT_DOUBLES_EQUAL(tracks_[i].covariance(2, 4),
+                                     soa.get<Covariance>(i).elements[reco::TrackBase::covIndex(2, 4)], 1e-6);
+    }
+}
+
+void testTrackSoA::checkRoundTrip() {
+    reco::TrackSoA soa(tracks_);
+    reco::TrackCollection tracks = soa.tracks();
+    CPPUNIT_ASSERT(tracks.size() == tracks_.size());
+    for (unsigned int i = 0; i < tracks.size(); ++i) {
+        auto const& t = tracks[i];
+        auto const& o = tracks_[i];
+        CPPUNIT_ASSERT_DOUBLES_EQUAL(o.px(), t.px(), 1e-5 * o.p());
+        CPPUNIT_ASSERT_DOUBLES_EQUAL(o.py(), t.py(), 1e-5 * o.p());
+        CPPUNIT_ASSERT_DOUBLES_EQUAL(o.pz(), t.pz(), 1e-5 * o.p());
+        CPPUNIT_ASSERT_DOUBLES_EQUAL(o.vz(), t.vz(), 1e-5);
+        CPPUNIT_ASSERT(o.chi2() == t.chi2());
+        CPPUNIT_ASSERT(o.ndof() == t.ndof());
+        CPPUNIT_ASSERT(o.charge() == t.charge());
+        CPPUNIT_ASSERT(o.algo() == t.algo());
+        CPPUNIT_ASSERT(o.originalAlgo() == t.originalAlgo());
+        CPPUNIT_ASSERT(o.algoMask() == t.algoMask());
+        CPPUNIT_ASSERT(o.qualityMask() == t.qualityMask());
+        CPPUNIT_ASSERT(o.hitPattern().numberOfAllHits(reco::HitPattern::TRACK_HITS) ==
+                       t.hitPattern().numberOfAllHits(reco::HitPattern::TRACK_HITS));
+        for (int j = 0; j < o.hitPattern().numberOfAllHits(reco::HitPattern::TRACK_HITS); ++j) {
+            CPPUNIT_ASSERT(o.hitPattern().getHitPattern(reco::HitPattern::TRACK_HITS, j) ==
+                           t.hitPattern().getHitPattern(reco::HitPattern::TRACK_HITS, j));
+        }
+        for (int j = 0; j < reco::TrackBase::dimension; ++j) {
+            for (int k = 0; k <= j; ++k) {
+                CPPUNIT_ASSERT(o.covariance(j, k) == t.covariance(j, k));
+            }
+        }
+    }
+}
+
+void testTrackSoA::checkTable() {
+    using namespace reco::trackcol;
+    edm::soa::Table<Pt, Phi, QualityMask> table(tracks_);
+    CPPUNIT_ASSERT(table.size() == tracks_.size());
+    for (unsigned int i = 0; i < table.size(); ++i) {
+        CPPUNIT_ASSERT_DOUBLES_EQUAL(tracks_[i].phi(), table.get<Phi>(i), 1e-5);
+        CPPUNIT_ASSERT(table.get<QualityMask>(i) == tracks_[i].qualityMask());
+    }
+}
@@ -0,0 +1,149 @@
+#ifndef FWCore_Concurrency_ParallelAlgorithms_h
+#define FWCore_Concurrency_ParallelAlgorithms_h
+// -*- C++ -*-
+//
+// Package:     Concurrency
+// Class  :     ParallelAlgorithms
+//
+/**\file ParallelAlgorithms.h "FWCore/Concurrency/interface/ParallelAlgorithms.h"
+
+ Description: Intra-event parallel loops for use inside a module's produce/analyze/filter
+
+ Usage:
+    edm::parallel_for and edm::parallel_reduce split an index range [iBegin, iEnd) into chunks
+ which are run by the TBB worker threads already used by the framework. No extra threads are
+ created and the global thread limit set by the job is honored.
+
+    The call blocks until all chunks are finished. While waiting, the calling thread is
+ isolated (tbb::this_task_arena::isolate) so that it can only pick up chunks of this loop and
+ never an unrelated framework task. Without this isolation a module holding a SharedResource or
+ running on a serial queue could start another module which needs the same resource and deadlock.
+
+    If the body throws, the remaining chunks are cancelled and the first exception caught is
+ rethrown unchanged on the calling thread, so cms::Exception context is kept as for any other
+ exception thrown from a module.
+
+    edm::parallel_reduce always splits the range into the same chunks, independent of the number
+ of threads, and combines them in the same order. Results (including floating point sums) are
+ therefore reproducible from job to job.
+
+ \code
+   unsigned int const nHits = hits.size();
+   edm::parallel_for(0U, nHits, [&](unsigned int i) { calibrated[i] = calibrate(hits[i]); });
+
+   double sum = edm::parallel_reduce(0U, nHits, 64U, 0.,
+                                     [&](unsigned int i) { return hits[i].energy(); },
+                                     std::plus<double>());
+ \endcode
+*/
+//
+//         Created:  Sun, 18 Oct 2026 13:05:39 GMT
+//
+
+// system include files
+#include <atomic>
+#include <exception>
+#include "tbb/blocked_range.h"
+#include "tbb/parallel_for.h"
+#include "tbb/parallel_reduce.h"
+#include "tbb/task_arena.h"
+#include "tbb/task_group.h"
+
+// user include files
+
+// forward declarations
+namespace edm {
+  namespace parallel_detail {
+    class ExceptionCollector {
+    public:
+      ExceptionCollector() : failed_{false} {}
+
+      ///Keeps the first exception and cancels the remaining work. Must be called from a catch block.
+      void collect(tbb::task_group_context& iContext) {
+        bool expected = false;
+        if (failed_.compare_exchange_strong(expected, true)) {
+          exception_ = std::current_exception();
+          iContext.cancel_group_execution();
+        }
+      }
+
+      void rethrowIfFailed() const {
+        if (exception_) {
+          std::rethrow_exception(exception_);
+        }
+      }
+
+    private:
+      std::atomic<bool> failed_;
+      std::exception_ptr exception_;
+    };
+  }  // namespace parallel_detail
+
+  /** Calls iBody(i) for every i in [iBegin, iEnd). Ranges of at least iGrainSize indices
+      are handed to each task. The order in which the indices are processed is unspecified. */
+  template <typename Index, typename Body>
+  void parallel_for(Index iBegin, Index iEnd, Index iGrainSize, Body const& iBody) {
+    if (not(iBegin < iEnd)) {
+      return;
+    }
+    parallel_detail::ExceptionCollector collector;
+    tbb::task_group_context context;
+    tbb::this_task_arena::isolate([&]() {
+      tbb::parallel_for(
+          tbb::blocked_range<Index>(iBegin, iEnd, iGrainSize),
+          [&](tbb::blocked_range<Index> const& iRange) {
+            try {
+              for (Index i = iRange.begin(); i != iRange.end(); ++i) {
+                iBody(i);
+              }
+            } catch (...) {
+              collector.collect(context);
+            }
+          },
+          tbb::auto_partitioner(),
+          context);
+    });
+    collector.rethrowIfFailed();
+  }
+
+  template <typename Index, typename Body>
+  void parallel_for(Index iBegin, Index iEnd, Body const& iBody) {
+    parallel_for(iBegin, iEnd, Index(1), iBody);
+  }
+
+  /** Returns iCombine(...iCombine(iCombine(iIdentity, iTransform(iBegin)), iTransform(iBegin+1))...)
+      evaluated in parallel. iCombine must be associative. The range is cut into chunks of at most
+      iGrainSize indices; the chunking and the order of combination only depend on iGrainSize so
+      the result does not depend on the number of threads. */
+  template <typename Index, typename T, typename Transform, typename Combine>
+  T parallel_reduce(
+      Index iBegin, Index iEnd, Index iGrainSize, T const& iIdentity, Transform const& iTransform, Combine const& iCombine) {
+    if (not(iBegin < iEnd)) {
+      return iIdentity;
+    }
+    parallel_detail::ExceptionCollector collector;
+    tbb::task_group_context context;
+    T result = tbb::this_task_arena::isolate([&]() {
+      return tbb::parallel_deterministic_reduce(
+          tbb::blocked_range<Index>(iBegin, iEnd, iGrainSize),
+          iIdentity,
+          [&](tbb::blocked_range<Index> const& iRange, T iValue) -> T {
+            try {
+              for (Index i = iRange.begin(); i != iRange.end(); ++i) {
+                iValue = iCombine(iValue, iTransform(i));
+              }
+            } catch (...) {
+              collector.collect(context);
+            }
+            return iValue;
+          },
+          iCombine,
+          tbb::simple_partitioner(),
+          context);
+    });
+    collector.rethrowIfFailed();
+    return result;
+  }
+}  // namespace edm
+
+#endif
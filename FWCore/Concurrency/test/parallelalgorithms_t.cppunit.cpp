@@ -0,0 +1,112 @@
+//
+//  parallelalgorithms_t.cppunit.cpp
+//
+//  Tests edm::parallel_for and edm::parallel_reduce
+//
+
+#include <atomic>
+#include <functional>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <cppunit/extensions/HelperMacros.h>
+#include "tbb/task_arena.h"
+#include "FWCore/Concurrency/interface/ParallelAlgorithms.h"
+
+class ParallelAlgorithms_test : public CppUnit::TestFixture {
+  CPPUNIT_TEST_SUITE(ParallelAlgorithms_test);
+  CPPUNIT_TEST(testFor);
+  CPPUNIT_TEST(testForEmpty);
+  CPPUNIT_TEST(testForException);
+  CPPUNIT_TEST(testReduce);
+  CPPUNIT_TEST(testReduceDeterministic);
+  CPPUNIT_TEST(testReduceException);
+  CPPUNIT_TEST_SUITE_END();
+
+public:
+  void testFor();
+  void testForEmpty();
+  void testForException();
+  void testReduce();
+  void testReduceDeterministic();
+  void testReduceException();
+  void setUp() {}
+  void tearDown() {}
+};
+
+CPPUNIT_TEST_SUITE_REGISTRATION(ParallelAlgorithms_test);
+
+void ParallelAlgorithms_test::testFor() {
+  constexpr unsigned int kSize = 10000;
+  std::vector<unsigned int> values(kSize, 0);
+  edm::parallel_for(0U, kSize, [&values](unsigned int i) { values[i] += i; });
+  for (unsigned int i = 0; i < kSize; ++i) {
+    CPPUNIT_ASSERT(values[i] == i);
+  }
+
+  std::atomic<unsigned int> count{0};
+  edm::parallel_for(0U, kSize, 100U, [&count](unsigned int) { ++count; });
+  CPPUNIT_ASSERT(count == kSize);
+}
+
+void ParallelAlgorithms_test::testForEmpty() {
+  std::atomic<unsigned int> count{0};
+  edm::parallel_for(5, 5, [&count](int) { ++count; });
+  edm::parallel_for(5, 2, [&count](int) { ++count; });
+  CPPUNIT_ASSERT(count == 0);
+}
+
+void ParallelAlgorithms_test::testForException() {
+  bool caught = false;
+  try {
+    edm::parallel_for(0, 1000, [](int i) {
+      if (i == 500) {
+        throw std::runtime_error("expected");
+      }
+    });
+  } catch (std::runtime_error const& iException) {
+    caught = std::string(iException.what()) == "expected";
+  }
+  CPPUNIT_ASSERT(caught);
+}
+
+void ParallelAlgorithms_test::testReduce() {
+  constexpr unsigned int kSize = 10000;
+  long sum =
+      edm::parallel_reduce(0U, kSize, 64U, 0L, [](unsigned int i) { return static_cast<long>(i); }, std::plus<long>());
+  CPPUNIT_ASSERT(sum == static_cast<long>(kSize) * (kSize - 1) / 2);
+
+  CPPUNIT_ASSERT(edm::parallel_reduce(3, 3, 1, 7, [](int) { return 1; }, std::plus<int>()) == 7);
+}
+
+void ParallelAlgorithms_test::testReduceDeterministic() {
+  constexpr unsigned int kSize = 100000;
+  auto term = [](unsigned int i) { return 1. / (1. + i); };
+  double reference = 0.;
+  {
+    tbb::task_arena serial(1);
+    reference = serial.execute([&]() { return edm::parallel_reduce(0U, kSize, 32U, 0., term, std::plus<double>()); });
+  }
+  for (unsigned int iTry = 0; iTry < 10; ++iTry) {
+    CPPUNIT_ASSERT(edm::parallel_reduce(0U, kSize, 32U, 0., term, std::plus<double>()) == reference);
+  }
+}
+
+void ParallelAlgorithms_test::testReduceException() {
+  bool caught = false;
+  try {
+    edm::parallel_reduce(
+        0, 1000, 10, 0,
+        [](int i) {
+          if (i == 500) {
+            throw std::runtime_error("expected");
+          }
+          return i;
+        },
+        std::plus<int>());
+  } catch (std::runtime_error const& iException) {
+    caught = std::string(iException.what()) == "expected";
+  }
+  CPPUNIT_ASSERT(caught);
+}
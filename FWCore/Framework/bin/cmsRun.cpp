@@ -368,6 +368,19 @@ int main(int argc, char* argv[]) {
 
       context = "Calling endJob";
       proc->endJob();
+
+      // the manifest is only an optimization for the next jobs: failing to write it
+      // must not fail this one
+      auto pluginManager = edmplugin::PluginManager::get();
+      if (not pluginManager->manifestIsComplete()) {
+        try {
+          pluginManager->writeManifest();
+        } catch (std::exception const& iE) {
+          edm::LogWarning("PluginManifest") << "Unable to write the plugin manifest: " << iE.what();
+        } catch (...) {
+          edm::LogWarning("PluginManifest") << "Unable to write the plugin manifest";
+        }
+      }
       return returnCode;
     });
   }
@@ -0,0 +1,37 @@
+#ifndef MessageLogger_SuppressedCategories_h
+#define MessageLogger_SuppressedCategories_h
+
+// ----------------------------------------------------------------------
+//
+// SuppressedCategories.h - Categories whose messages no destination
+//		    would ever output.
+//
+//   The MessageLogger scribe fills this when it is configured: a category
+//   with limit 0 in every ordinary destination, and below the threshold of
+//   every statistics destination, is dropped when the MessageSender is
+//   built, so that no ErrorObj is allocated and nothing is formatted or
+//   queued for it.  The same is done for the severities handled by
+//   MessageDrop::*AlwaysSuppressed.
+//
+//   As long as no category is suppressed, the check is a single load and
+//   branch.  Messages counted by LoggedErrorsSummary (warnings and above,
+//   when enabled) and LogSystem/LogAbsolute messages are never dropped.
+//
+// ----------------------------------------------------------------------
+
+#include "FWCore/MessageLogger/interface/ELseverityLevel.h"
+
+#include <map>
+#include <string>
+
+namespace edm {
+
+// Messages of the category with a severity level (ELseverityLevel::getLevel())
+// strictly lower than the value are dropped.  Replaces the previous settings.
+void setSuppressedCategories(std::map<std::string, int> const& iLevels);
+bool categoryIsSuppressed(ELseverityLevel const& iSeverity, std::string const& iCategory);
+
+}        // end of namespace edm
+
+
+#endif  // MessageLogger_SuppressedCategories_h
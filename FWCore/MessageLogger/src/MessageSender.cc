@@ -2,6 +2,7 @@
 #include "FWCore/MessageLogger/interface/MessageSender.h"
 #include "FWCore/MessageLogger/interface/MessageLoggerQ.h"
 #include "FWCore/MessageLogger/interface/MessageDrop.h"
+#include "FWCore/MessageLogger/interface/SuppressedCategories.h"
 #include "FWCore/Utilities/interface/thread_safety_macros.h"
 
 #include <algorithm>
@@ -9,6 +10,10 @@
 #include <vector>
 #include <limits>
 #include <atomic>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
 
 #include <functional>
 #include "tbb/concurrent_unordered_map.h"
@@ -84,10 +89,15 @@ CMS_THREAD_SAFE static std::atomic<bool> errorSummaryIsBeingKept{false};
 //Each item in the vector is reserved for a different Stream
 CMS_THREAD_SAFE static std::vector<tbb::concurrent_unordered_map<ErrorSummaryMapKey, AtomicUnsignedInt,ErrorSummaryMapKey::key_hash>> errorSummaryMaps;
 
+typedef std::unordered_map<std::string, int> SuppressedCategoriesMap;
+//nullptr as long as no category is suppressed. A published map is never modified
+// nor deleted, since a sender on another thread may still be reading it
+static std::atomic<SuppressedCategoriesMap const*> suppressedCategories{nullptr};
+
 MessageSender::MessageSender( ELseverityLevel const & sev, 
 			      ELstring const & id,
 			      bool verbatim, bool suppressed )
-: errorobj_p( suppressed ? nullptr : new ErrorObj(sev,id,verbatim), ErrorObjDeleter())
+: errorobj_p( (suppressed || categoryIsSuppressed(sev,id)) ? nullptr : new ErrorObj(sev,id,verbatim), ErrorObjDeleter())
 {
   //std::cout << "MessageSender ctor; new ErrorObj at: " << errorobj_p << '\n';
 }
@@ -199,6 +209,32 @@ namespace edm {
     errorSummaryMaps.resize(iMax);
   }
 
+  void setSuppressedCategories(std::map<std::string, int> const& iLevels) {
+    static std::mutex s_mutex;
+    CMS_THREAD_GUARD(s_mutex) static std::vector<std::unique_ptr<SuppressedCategoriesMap const>> s_published;
+
+    std::lock_guard<std::mutex> guard(s_mutex);
+    SuppressedCategoriesMap const* categories = nullptr;
+    if (!iLevels.empty()) {
+      s_published.emplace_back(new SuppressedCategoriesMap(iLevels.begin(), iLevels.end()));
+      categories = s_published.back().get();
+    }
+    suppressedCategories.store(categories, std::memory_order_release);
+  }
+
+  bool categoryIsSuppressed(ELseverityLevel const& iSeverity, std::string const& iCategory) {
+    SuppressedCategoriesMap const* categories = suppressedCategories.load(std::memory_order_acquire);
+    if (categories == nullptr) {
+      return false;
+    }
+    if (iSeverity >= ELsevere ||
+        (iSeverity >= ELwarning && errorSummaryIsBeingKept.load(std::memory_order_acquire))) {
+      return false;
+    }
+    auto found = categories->find(iCategory);
+    return found != categories->end() && iSeverity.getLevel() < found->second;
+  }
+
   
   std::vector<ErrorSummaryEntry> LoggedErrorsOnlySummary(unsigned int iStreamID) {    //  ChangeLog 2
     std::vector<ErrorSummaryEntry> v;
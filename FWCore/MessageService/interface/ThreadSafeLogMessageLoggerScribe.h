@@ -16,6 +16,7 @@
 #include <iosfwd>
 #include <vector>
 #include <map>
+#include <set>
 
 #include <iostream>
 #include <atomic>
@@ -71,6 +72,7 @@ private:
   void  configure_dest( std::shared_ptr<ELdestination> dest_ctrl
                       , String const &  filename
 		      );
+  void  publish_suppressed_categories( );
 
   template <class T>						// ChangeLog 11
   T getAparameter ( PSet const& p, std::string const & id, T const & def ) 
@@ -93,6 +95,13 @@ private:
   // --- other helpers
   void parseCategories (std::string const & s, std::vector<std::string> & cats);
   
+  // --- what each configured destination lets through, used to find
+  //     the categories which can be dropped before being formatted
+  struct DestinationFilter {
+    int threshold;
+    std::set<String> zeroLimitCategories;
+  };
+
   // --- data:
   edm::propagate_const<std::shared_ptr<ELadministrator>>  admin_p;
   std::shared_ptr<ELdestination>                       early_dest;
@@ -102,6 +111,7 @@ private:
   std::vector<String> 	  	      ordinary_destination_filenames;
   std::vector<std::shared_ptr<ELstatistics>> statisticsDestControls;
   std::vector<bool>                   statisticsResets;
+  std::vector<DestinationFilter>      destinationFilters;
   bool				      clean_slate_configuration;
   value_ptr<MessageLoggerDefaults>    messageLoggerDefaults;
   bool				      active;
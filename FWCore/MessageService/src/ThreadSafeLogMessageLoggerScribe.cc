@@ -20,6 +20,7 @@
 #include "FWCore/MessageLogger/interface/ConfigurationHandshake.h"
 #include "FWCore/MessageLogger/interface/MessageDrop.h"		// change log 37
 #include "FWCore/MessageLogger/interface/ELseverityLevel.h"	// change log 37
+#include "FWCore/MessageLogger/interface/SuppressedCategories.h"
 
 #include "FWCore/Utilities/interface/EDMException.h"
 #include "FWCore/Utilities/interface/Algorithms.h"
@@ -235,10 +236,46 @@ namespace edm {
       m_waitingThreshold = getAparameter<unsigned int>(*job_pset_p,
                                                       "waiting_threshold",
                                                       100);
+      destinationFilters.clear();
       configure_ordinary_destinations();				// Change Log 16
       configure_statistics();					// Change Log 16
+      if (clean_slate_configuration) {
+        publish_suppressed_categories();
+      } else {
+        // The destinations of the earlier configuration stay attached and
+        // their limits are not known here, so nothing may be dropped early.
+        setSuppressedCategories({});
+      }
     }  // ThreadSafeLogMessageLoggerScribe::configure_errorlog()
     
+    void
+    ThreadSafeLogMessageLoggerScribe::publish_suppressed_categories()
+    {
+      // A message of category c is dropped by a destination if its severity
+      // is below the threshold, or below ELsevere when c has limit 0 there.
+      // When all destinations drop it, it need not be built at all.
+      int const severe = ELseverityLevel(ELseverityLevel::ELsev_severe).getLevel();
+      int lowestThreshold = severe;
+      for (auto const& filter : destinationFilters) {
+        lowestThreshold = std::min(lowestThreshold, filter.threshold);
+      }
+      std::map<String, int> levels;
+      for (auto const& filter : destinationFilters) {
+        for (auto const& category : filter.zeroLimitCategories) {
+          if (levels.find(category) != levels.end()) continue;
+          int level = severe;
+          for (auto const& other : destinationFilters) {
+            if (other.zeroLimitCategories.count(category) == 0) {
+              level = std::min(level, other.threshold);
+            }
+          }
+          // otherwise the thresholds already do the job
+          if (level > lowestThreshold) levels[category] = level;
+        }
+      }
+      setSuppressedCategories(levels);
+    }
+    
     
     
     
@@ -351,6 +388,8 @@ namespace edm {
       if (dest_threshold == empty_String) dest_threshold = COMMON_DEFAULT_THRESHOLD;
       ELseverityLevel  threshold_sev(dest_threshold);
       dest_ctrl->setThreshold(threshold_sev);
+      DestinationFilter filter;
+      filter.threshold = threshold_sev.getLevel();
       // change log 37
       if (threshold_sev <= ELseverityLevel::ELsev_success)
       { edm::MessageDrop::debugAlwaysSuppressed = false; }
@@ -404,6 +443,7 @@ namespace edm {
         if( limit     != NO_VALUE_SET )  {
           if ( limit < 0 ) limit = 2000000000;
           dest_ctrl->setLimit(msgID, limit);
+          if ( limit == 0 ) filter.zeroLimitCategories.insert(msgID);
         }  						// change log 2a, 2b
         if( interval  != NO_VALUE_SET )  {
           dest_ctrl->setInterval(msgID, interval);
@@ -414,6 +454,7 @@ namespace edm {
         }						// change log 2a, 2b
         
       }  // for
+      destinationFilters.push_back(filter);
       
       // establish this destination's limit for each severity:
       for( vString::const_iterator sev_it = severities.begin()
@@ -745,7 +786,12 @@ namespace edm {
           statisticsResets.push_back(reset);
           
           // now configure this destination:
+          auto const nFilters = destinationFilters.size();
           configure_dest(stat, psetname);
+          // statistics count the messages whatever the limits
+          if (destinationFilters.size() != nFilters) {
+            destinationFilters.back().zeroLimitCategories.clear();
+          }
           
           // and suppress the desire to do an extra termination summary just because
           // of end-of-job info messages
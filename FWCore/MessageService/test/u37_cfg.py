@@ -0,0 +1,57 @@
+# Unit test configuration file for MessageLogger service:
+# A category with limit 0 in some destinations is still sent to the others,
+# and to the statistics destinations.  A category dropped by every destination
+# (limit 0 in all the ordinary ones, below the threshold of the statistics)
+# is not even formatted; the outputs must be the same as if it were.
+#
+
+import FWCore.ParameterSet.Config as cms
+
+process = cms.Process("TEST")
+
+import FWCore.Framework.test.cmsExceptionsFatal_cff
+process.options = FWCore.Framework.test.cmsExceptionsFatal_cff.options
+
+process.load("FWCore.MessageService.test.Services_cff")
+
+process.MessageLogger = cms.Service("MessageLogger",
+    u37_zero = cms.untracked.PSet(
+        threshold = cms.untracked.string('INFO'),
+        noTimeStamps = cms.untracked.bool(True),
+        cat_A = cms.untracked.PSet(
+            limit = cms.untracked.int32(0)
+        ),
+        cat_B = cms.untracked.PSet(
+            limit = cms.untracked.int32(0)
+        )
+    ),
+    u37_some = cms.untracked.PSet(
+        threshold = cms.untracked.string('INFO'),
+        noTimeStamps = cms.untracked.bool(True),
+        FwkReport = cms.untracked.PSet(
+            limit = cms.untracked.int32(0)
+        ),
+        cat_B = cms.untracked.PSet(
+            limit = cms.untracked.int32(0)
+        )
+    ),
+    u37_statistics = cms.untracked.PSet(
+        threshold = cms.untracked.string('WARNING')
+    ),
+    statistics = cms.untracked.vstring('u37_statistics'),
+    categories = cms.untracked.vstring('FwkReport', 
+        'cat_A', 
+        'cat_B'),
+    destinations = cms.untracked.vstring('u37_zero', 
+        'u37_some')
+)
+
+process.maxEvents = cms.untracked.PSet(
+    input = cms.untracked.int32(1)
+)
+
+process.source = cms.Source("EmptySource")
+
+process.sendSomeMessages = cms.EDAnalyzer("UnitTestClient_X")
+
+process.p = cms.Path(process.sendSomeMessages)
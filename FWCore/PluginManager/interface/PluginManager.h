@@ -12,6 +12,14 @@
  Usage:
     <usage>
 
+    If a manifest file is given in the Config, the plugins listed there are looked up directly in it and the
+ .edmplugincache files of the search path are only read once a plugin is requested which is not in the
+ manifest (or once categoryToInfos() is called). A manifest only applies to the search path it was written
+ for, and only as long as none of the .edmplugincache files of that search path changed (their size and
+ modification time are recorded in it). writeManifest() records all the plugins looked up so far in addition to
+ those already in the manifest, so a job run once with a manifest file which does not exist yet leaves the
+ manifest for the following runs of the same configuration.
+
 */
 //
 // Original Author:  Chris Jones
@@ -63,8 +71,16 @@ class PluginManager
        const SearchPath& searchPath() const {
          return m_path;
        }
+       Config& manifestFile(const std::string& iFile) {
+         m_manifestFile = iFile;
+         return *this;
+       }
+       const std::string& manifestFile() const {
+         return m_manifestFile;
+       }
        private:
        SearchPath m_path;
+       std::string m_manifestFile;
      };
 
       ~PluginManager();
@@ -79,13 +95,18 @@ class PluginManager
       /**The container is ordered by category, then plugin name and then by precidence order of the plugin files.
         Therefore the first match on category and plugin name will be the proper file to load
         */
-      const CategoryToInfos& categoryToInfos() const {
-        return categoryToInfos_;
-      }
+      const CategoryToInfos& categoryToInfos() const;
       
       //If can not find iPlugin in category iCategory return null pointer, any other failure will cause a throw
       const SharedLibrary* tryToLoad(const std::string& iCategory,
                                      const std::string& iPlugin);
+
+      ///true if all the plugins looked up so far were found in the manifest file
+      bool manifestIsComplete() const;
+
+      ///writes the plugins looked up so far, and those of the current manifest, to the manifest file given in
+      /// the Config, returns false if none was given. Throws if the file cannot be written; nothing is left behind then
+      bool writeManifest() const;
       
       // ---------- static member functions --------------------
       ///file name of the shared object being loaded
@@ -120,12 +141,26 @@ class PluginManager
       const boost::filesystem::path& loadableFor_(const std::string& iCategory,
                                                   const std::string& iPlugin,
                                                   bool& ioThrowIfFailElseSucceedStatus);
+      bool readManifest();
+      void readCacheFiles() const;
+      void recordUsed(const std::string& iCategory, const std::string& iPlugin,
+                      const boost::filesystem::path& iLoadable, bool iFromManifest);
       // ---------- member data --------------------------------
       SearchPath searchPath_;
+      std::string manifestFile_;
+      //the cache files of the search path, as recorded in the manifest
+      std::string cacheFilesState_;
       tbb::concurrent_unordered_map<boost::filesystem::path, std::shared_ptr<SharedLibrary>, PluginManagerPathHasher > loadables_;
       
-      CategoryToInfos categoryToInfos_;
+      CategoryToInfos manifestInfos_;
+      //filled from the cache files the first time they are needed, guarded by cacheFilesRead_
+      mutable CategoryToInfos categoryToInfos_;
+      mutable std::once_flag cacheFilesRead_;
       std::recursive_mutex pluginLoadMutex_;
+
+      mutable std::mutex usedMutex_;
+      std::map<std::pair<std::string, std::string>, boost::filesystem::path> used_;
+      bool usedOutsideManifest_ = false;
 };
 
 }
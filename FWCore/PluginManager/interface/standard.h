@@ -30,6 +30,12 @@
 namespace edmplugin {
   namespace standard {
 
+    /**The search path is taken from LD_LIBRARY_PATH (DYLD_FALLBACK_LIBRARY_PATH on macOS).
+       If CMSSW_PLUGIN_MANIFEST is set, it names the manifest file (see PluginManager) which lists
+       the plugins a previous job of the same configuration used. The file is written at the end of
+       a successful cmsRun job and is reused as long as the search path and its .edmplugincache
+       files are unchanged.
+     */
     PluginManager::Config config();
     
     const boost::filesystem::path& cachefileName();
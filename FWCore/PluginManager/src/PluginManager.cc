@@ -12,10 +12,12 @@
 
 // system include files
 #include <boost/filesystem/operations.hpp>
+#include <boost/filesystem/convenience.hpp>
 
 #include <fstream>
 #include <functional>
 #include <set>
+#include <sstream>
 
 // TEMPORARY
 #include "TInterpreter.h"
@@ -57,15 +59,53 @@ static bool readCacheFile(const boost::filesystem::path &cacheFile,
 //
 // constructors and destructor
 //
+static const std::string kManifestHeader("#edmpluginmanifest ");
+static const std::string kManifestCacheFile("#edmplugincache ");
+
+static std::string joinedSearchPath(const PluginManager::SearchPath& iPath) {
+  std::string joined;
+  for(auto const& dir : iPath) {
+    if(not joined.empty()) {
+      joined += ':';
+    }
+    joined += dir;
+  }
+  return joined;
+}
+
+// One line per cache file the search path can provide, existing or not, with its size and
+// modification time. A manifest is only used if this is the same as when it was written, so
+// that it can never resolve a plugin differently from the cache files.
+static std::string cacheFilesState(const PluginManager::SearchPath& iPath) {
+  std::ostringstream state;
+  std::set<std::string> alreadySeen;
+  for(auto const& dir : iPath) {
+    if(not alreadySeen.insert(dir).second) {
+      continue;
+    }
+    for(auto const& name : {standard::cachefileName(), standard::poisonedCachefileName()}) {
+      boost::filesystem::path cacheFile = boost::filesystem::path(dir)/name;
+      boost::system::error_code ec;
+      auto size = boost::filesystem::file_size(cacheFile, ec);
+      auto time = ec ? 0 : boost::filesystem::last_write_time(cacheFile, ec);
+      state << kManifestCacheFile;
+      if(ec) {
+        state << "- -";
+      } else {
+        state << size << " " << time;
+      }
+      state << " " << cacheFile.string() << "\n";
+    }
+  }
+  return state.str();
+}
+
 PluginManager::PluginManager(const PluginManager::Config& iConfig) :
-  searchPath_( iConfig.searchPath() )
+  searchPath_( iConfig.searchPath() ),
+  manifestFile_( iConfig.manifestFile() ),
+  cacheFilesState_( manifestFile_.empty() ? std::string() : cacheFilesState(searchPath_) )
 {
     using std::placeholders::_1;
-    const boost::filesystem::path& kCacheFile(standard::cachefileName());
-    // This is the filename of a file which contains plugins which exist in the
-    // base release and which should exists in the local area, otherwise they
-    // were removed and we want to catch their usage.
-    const boost::filesystem::path& kPoisonedCacheFile(standard::poisonedCachefileName());
     //NOTE: This may not be needed :/
     PluginFactoryManager* pfm = PluginFactoryManager::get();
     pfm->newFactory_.connect(std::bind(std::mem_fn(&PluginManager::newFactory),this,_1));
@@ -78,6 +118,61 @@ PluginManager::PluginManager(const PluginManager::Config& iConfig) :
     	categoryToInfos_[(*i)->category()] = (*i)->available();
     }
 
+    if(not readManifest()) {
+      readCacheFiles();
+    }
+    //Since this should not be called until after 'main' has started, we can set the value
+    loadingLibraryNamed_()="<loaded by another plugin system>";
+}
+
+bool
+PluginManager::readManifest()
+{
+  if(manifestFile_.empty() or not exists(boost::filesystem::path(manifestFile_))) {
+    return false;
+  }
+  std::ifstream file(manifestFile_.c_str());
+  std::string header;
+  if(not std::getline(file, header) or
+     header.compare(0, kManifestHeader.size(), kManifestHeader) != 0 or
+     header.substr(kManifestHeader.size()) != joinedSearchPath(searchPath_)) {
+    //written by another version of the manager or for another environment
+    return false;
+  }
+  std::string cacheFiles;
+  while(file.peek() == '#' and std::getline(file, header)) {
+    if(header.compare(0, kManifestCacheFile.size(), kManifestCacheFile) == 0) {
+      cacheFiles += header + "\n";
+    }
+  }
+  if(cacheFiles != cacheFilesState_) {
+    //a cache file was added, removed or rebuilt (e.g. by a local scram b) since the manifest was written
+    return false;
+  }
+  CategoryToInfos infos;
+  CacheParser::read(file, boost::filesystem::path(), infos);
+  for(auto const& category : infos) {
+    for(auto const& info : category.second) {
+      if(not exists(info.loadable_)) {
+        //the release area changed since the manifest was written
+        return false;
+      }
+    }
+  }
+  manifestInfos_.swap(infos);
+  return true;
+}
+
+void
+PluginManager::readCacheFiles() const
+{
+  std::call_once(cacheFilesRead_, [this]() {
+    const boost::filesystem::path& kCacheFile(standard::cachefileName());
+    // This is the filename of a file which contains plugins which exist in the
+    // base release and which should exists in the local area, otherwise they
+    // were removed and we want to catch their usage.
+    const boost::filesystem::path& kPoisonedCacheFile(standard::poisonedCachefileName());
+
     //read in the files
     //Since we are looping in the 'precidence' order then the lists in categoryToInfos_ will also be
     // in that order
@@ -116,8 +211,7 @@ PluginManager::PluginManager(const PluginManager::Config& iConfig) :
       }
       throw ex;
     }
-    //Since this should not be called until after 'main' has started, we can set the value
-    loadingLibraryNamed_()="<loaded by another plugin system>";
+  });
 }
 
 // PluginManager::PluginManager(const PluginManager& rhs)
@@ -175,6 +269,24 @@ PluginManager::loadableFor_(const std::string& iCategory,
 {
   const bool throwIfFail = ioThrowIfFailElseSucceedStatus;
   ioThrowIfFailElseSucceedStatus = true;
+
+  PluginInfo i;
+  i.name_ = iPlugin;
+  typedef std::vector<PluginInfo>::iterator PIItr;
+
+  CategoryToInfos::iterator itManifest = manifestInfos_.find(iCategory);
+  if(itManifest != manifestInfos_.end()) {
+    std::pair<PIItr,PIItr> range = std::equal_range(itManifest->second.begin(),
+                                                    itManifest->second.end(),
+                                                    i,
+                                                    PICompare() );
+    if(range.first != range.second) {
+      recordUsed(iCategory, iPlugin, range.first->loadable_, true);
+      return range.first->loadable_;
+    }
+  }
+  readCacheFiles();
+
   CategoryToInfos::iterator itFound = categoryToInfos_.find(iCategory);
   if(itFound == categoryToInfos_.end()) {
     if(throwIfFail) {
@@ -187,9 +299,6 @@ PluginManager::loadableFor_(const std::string& iCategory,
     }
   }
   
-  PluginInfo i;
-  i.name_ = iPlugin;
-  typedef std::vector<PluginInfo>::iterator PIItr;
   std::pair<PIItr,PIItr> range = std::equal_range(itFound->second.begin(),
                                                   itFound->second.end(),
                                                   i,
@@ -223,9 +332,91 @@ PluginManager::loadableFor_(const std::string& iCategory,
     }
   }
   
+  recordUsed(iCategory, iPlugin, range.first->loadable_, false);
   return range.first->loadable_;
 }
 
+void
+PluginManager::recordUsed(const std::string& iCategory, const std::string& iPlugin,
+                          const boost::filesystem::path& iLoadable, bool iFromManifest)
+{
+  if(manifestFile_.empty() or iLoadable == staticallyLinkedLoadingFileName()) {
+    return;
+  }
+  std::lock_guard<std::mutex> guard(usedMutex_);
+  used_.emplace(std::make_pair(iCategory, iPlugin), iLoadable);
+  if(not iFromManifest) {
+    usedOutsideManifest_ = true;
+  }
+}
+
+const PluginManager::CategoryToInfos&
+PluginManager::categoryToInfos() const
+{
+  readCacheFiles();
+  return categoryToInfos_;
+}
+
+bool
+PluginManager::manifestIsComplete() const
+{
+  std::lock_guard<std::mutex> guard(usedMutex_);
+  return not manifestInfos_.empty() and not usedOutsideManifest_;
+}
+
+bool
+PluginManager::writeManifest() const
+{
+  if(manifestFile_.empty()) {
+    return false;
+  }
+  //keep what the manifest already had, so that configurations sharing a manifest complete it
+  //instead of overwriting each other's plugins
+  std::map<std::pair<std::string, std::string>, boost::filesystem::path> plugins;
+  for(auto const& category : manifestInfos_) {
+    for(auto const& info : category.second) {
+      plugins.emplace(std::make_pair(category.first, info.name_), info.loadable_);
+    }
+  }
+  {
+    std::lock_guard<std::mutex> guard(usedMutex_);
+    for(auto const& entry : used_) {
+      plugins[entry.first] = entry.second;
+    }
+  }
+  CacheParser::LoadableToPlugins ordered;
+  for(auto const& entry : plugins) {
+    ordered[boost::filesystem::system_complete(entry.second)].push_back(CacheParser::NameAndType(entry.first.second, entry.first.first));
+  }
+
+  //several jobs may share the manifest: write to a private file and move it in place
+  boost::filesystem::path manifest(manifestFile_);
+  boost::filesystem::path tmp;
+  try {
+    tmp = boost::filesystem::unique_path(manifest.string() + ".%%%%-%%%%-%%%%");
+    {
+      std::ofstream file(tmp.string().c_str());
+      if(not file) {
+        throw cms::Exception("PluginManagerManifestProblem")<<"Unable to write the plugin manifest '"<<tmp.string()<<"'";
+      }
+      file << kManifestHeader << joinedSearchPath(searchPath_) << "\n" << cacheFilesState_;
+      CacheParser::write(ordered, file);
+      file.close();
+      if(not file) {
+        throw cms::Exception("PluginManagerManifestProblem")<<"Unable to write the plugin manifest '"<<tmp.string()<<"'";
+      }
+    }
+    boost::filesystem::rename(tmp, manifest);
+  } catch(...) {
+    if(not tmp.empty()) {
+      boost::system::error_code ec;
+      boost::filesystem::remove(tmp, ec);
+    }
+    throw;
+  }
+  return true;
+}
+
 namespace {
   class Sentry {
 public:
@@ -40,6 +40,10 @@ namespace edmplugin {
       }
       paths.push_back(spath.substr(last,std::string::npos));
       returnValue.searchPath(paths);
+
+      // a per-configuration list of the plugins used, see PluginManager
+      const char *manifest = getenv ("CMSSW_PLUGIN_MANIFEST");
+      if (manifest) returnValue.manifestFile(manifest);
       
       return returnValue;
   }
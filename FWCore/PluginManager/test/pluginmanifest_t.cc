@@ -0,0 +1,195 @@
+// -*- C++ -*-
+//
+// Package:     PluginManager
+// Class  :     pluginmanifest_t
+//
+// Implementation:
+//     The PluginManager is a singleton which can only be configured once per process, so each
+//     job of the test runs in its own child process.
+//
+
+// system include files
+#include <Utilities/Testing/interface/CppUnit_testdriver.icpp>
+#include <cppunit/extensions/HelperMacros.h>
+#include <boost/filesystem/operations.hpp>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <sys/wait.h>
+#include <unistd.h>
+
+// user include files
+#include "FWCore/PluginManager/interface/CacheParser.h"
+#include "FWCore/PluginManager/interface/PluginManager.h"
+#include "FWCore/PluginManager/interface/standard.h"
+#include "FWCore/Utilities/interface/Exception.h"
+
+class TestPluginManifest : public CppUnit::TestFixture
+{
+  CPPUNIT_TEST_SUITE(TestPluginManifest);
+  CPPUNIT_TEST(test);
+  CPPUNIT_TEST_SUITE_END();
+public:
+    void test();
+    void setUp();
+    void tearDown();
+private:
+    boost::filesystem::path top_;
+};
+
+///registration of the test so that the runner can find it
+CPPUNIT_TEST_SUITE_REGISTRATION(TestPluginManifest);
+
+namespace {
+  const std::string kCategory("Test Dummy");
+
+  //the job is run in a child process, returns true if it succeeded
+  bool runJob(std::function<void()> iJob) {
+    std::cout.flush();
+    pid_t pid = fork();
+    if(pid == 0) {
+      int status = 0;
+      try {
+        iJob();
+      } catch(CppUnit::Exception const& iE) {
+        std::cerr <<"line "<<iE.sourceLine().lineNumber()<<": "<<iE.what()<<std::endl;
+        status = 1;
+      } catch(std::exception const& iE) {
+        std::cerr <<iE.what()<<std::endl;
+        status = 1;
+      }
+      _exit(status);
+    }
+    int status = 0;
+    waitpid(pid, &status, 0);
+    return WIFEXITED(status) and WEXITSTATUS(status) == 0;
+  }
+
+  void writeCacheFile(const boost::filesystem::path& iDir,
+                      const std::vector<std::pair<std::string, std::string>>& iLoadableAndPlugins) {
+    edmplugin::CacheParser::LoadableToPlugins plugins;
+    for(auto const& entry : iLoadableAndPlugins) {
+      plugins[entry.first].push_back(edmplugin::CacheParser::NameAndType(entry.second, kCategory));
+      std::ofstream(( iDir/entry.first ).string().c_str());
+    }
+    std::ofstream file(( iDir/edmplugin::standard::cachefileName() ).string().c_str());
+    edmplugin::CacheParser::write(plugins, file);
+  }
+
+  edmplugin::PluginManager& configure(const std::vector<boost::filesystem::path>& iDirs,
+                                      const boost::filesystem::path& iManifest) {
+    edmplugin::PluginManager::Config config;
+    edmplugin::PluginManager::SearchPath path;
+    for(auto const& dir : iDirs) {
+      path.push_back(dir.string());
+    }
+    config.searchPath(path);
+    config.manifestFile(iManifest.string());
+    return edmplugin::PluginManager::configure(config);
+  }
+
+  unsigned int nFilesIn(const boost::filesystem::path& iDir) {
+    return std::distance(boost::filesystem::directory_iterator(iDir), boost::filesystem::directory_iterator());
+  }
+}
+
+void
+TestPluginManifest::setUp()
+{
+  top_ = boost::filesystem::temp_directory_path()/boost::filesystem::unique_path("pluginmanifest_t-%%%%-%%%%");
+  boost::filesystem::create_directories(top_/"lib");
+  boost::filesystem::create_directories(top_/"otherlib");
+  boost::filesystem::create_directories(top_/"manifest");
+}
+
+void
+TestPluginManifest::tearDown()
+{
+  boost::filesystem::remove_all(top_);
+}
+
+void
+TestPluginManifest::test()
+{
+  const boost::filesystem::path lib = top_/"lib";
+  const boost::filesystem::path otherlib = top_/"otherlib";
+  const boost::filesystem::path manifestDir = top_/"manifest";
+  const boost::filesystem::path manifest = manifestDir/"plugins.manifest";
+  writeCacheFile(lib, {{"pluginOne.so", "DummyOne"}, {"pluginTwo.so", "DummyTwo"}});
+
+  //write: the first job has no manifest yet
+  CPPUNIT_ASSERT(runJob([&]() {
+    auto& pm = configure({lib}, manifest);
+    CPPUNIT_ASSERT(not pm.manifestIsComplete());
+    CPPUNIT_ASSERT(pm.loadableFor(kCategory, "DummyOne") == lib/"pluginOne.so");
+    CPPUNIT_ASSERT(not pm.manifestIsComplete());
+    CPPUNIT_ASSERT(pm.writeManifest());
+  }));
+  CPPUNIT_ASSERT(exists(manifest));
+  CPPUNIT_ASSERT(nFilesIn(manifestDir) == 1); //no temporary file left
+
+  //read back: the plugin comes from the manifest
+  CPPUNIT_ASSERT(runJob([&]() {
+    auto& pm = configure({lib}, manifest);
+    CPPUNIT_ASSERT(pm.loadableFor(kCategory, "DummyOne") == lib/"pluginOne.so");
+    CPPUNIT_ASSERT(pm.manifestIsComplete());
+  }));
+
+  //another configuration using another plugin adds it to the manifest instead of replacing it
+  CPPUNIT_ASSERT(runJob([&]() {
+    auto& pm = configure({lib}, manifest);
+    CPPUNIT_ASSERT(pm.loadableFor(kCategory, "DummyTwo") == lib/"pluginTwo.so");
+    CPPUNIT_ASSERT(not pm.manifestIsComplete());
+    CPPUNIT_ASSERT(pm.writeManifest());
+  }));
+  CPPUNIT_ASSERT(runJob([&]() {
+    auto& pm = configure({lib}, manifest);
+    CPPUNIT_ASSERT(pm.loadableFor(kCategory, "DummyOne") == lib/"pluginOne.so");
+    CPPUNIT_ASSERT(pm.loadableFor(kCategory, "DummyTwo") == lib/"pluginTwo.so");
+    CPPUNIT_ASSERT(pm.manifestIsComplete());
+  }));
+
+  //a manifest written for another search path is ignored
+  writeCacheFile(otherlib, {{"otherOne.so", "DummyOne"}});
+  CPPUNIT_ASSERT(runJob([&]() {
+    auto& pm = configure({otherlib, lib}, manifest);
+    CPPUNIT_ASSERT(pm.loadableFor(kCategory, "DummyOne") == otherlib/"otherOne.so");
+    CPPUNIT_ASSERT(not pm.manifestIsComplete());
+  }));
+
+  //a manifest is ignored once one of the cache files changed, e.g. after a local rebuild
+  CPPUNIT_ASSERT(runJob([&]() {
+    auto& pm = configure({lib}, manifest);
+    CPPUNIT_ASSERT(pm.loadableFor(kCategory, "DummyOne") == lib/"pluginOne.so");
+    CPPUNIT_ASSERT(pm.manifestIsComplete());
+  }));
+  writeCacheFile(lib, {{"pluginOneRebuilt.so", "DummyOne"}, {"pluginTwo.so", "DummyTwo"}});
+  CPPUNIT_ASSERT(runJob([&]() {
+    auto& pm = configure({lib}, manifest);
+    CPPUNIT_ASSERT(pm.loadableFor(kCategory, "DummyOne") == lib/"pluginOneRebuilt.so");
+    CPPUNIT_ASSERT(pm.loadableFor(kCategory, "DummyTwo") == lib/"pluginTwo.so");
+    CPPUNIT_ASSERT(not pm.manifestIsComplete());
+    CPPUNIT_ASSERT(pm.writeManifest());
+  }));
+
+  //a manifest is ignored if one of its loadables is missing
+  CPPUNIT_ASSERT(runJob([&]() {
+    auto& pm = configure({lib}, manifest);
+    CPPUNIT_ASSERT(pm.loadableFor(kCategory, "DummyTwo") == lib/"pluginTwo.so");
+    CPPUNIT_ASSERT(pm.manifestIsComplete());
+  }));
+  boost::filesystem::remove(lib/"pluginTwo.so");
+  CPPUNIT_ASSERT(runJob([&]() {
+    auto& pm = configure({lib}, manifest);
+    CPPUNIT_ASSERT(pm.loadableFor(kCategory, "DummyOne") == lib/"pluginOneRebuilt.so");
+    CPPUNIT_ASSERT(not pm.manifestIsComplete());
+  }));
+
+  //a manifest which cannot be written throws and leaves nothing behind
+  CPPUNIT_ASSERT(runJob([&]() {
+    auto& pm = configure({lib}, top_/"missing"/"plugins.manifest");
+    pm.loadableFor(kCategory, "DummyOne");
+    CPPUNIT_ASSERT_THROW(pm.writeManifest(), cms::Exception);
+  }));
+  CPPUNIT_ASSERT(not exists(top_/"missing"));
+}
@@ -84,8 +84,8 @@ public:
   const_iterator end() const { return const_iterator{m_values,size()}; }
   
 private:
-  std::array<void const*, sizeof...(Args)> m_values;
   unsigned int m_size;
+  std::array<void const*, sizeof...(Args)> m_values;
   
   template<typename U>
   void const* columnAddress() const {
@@ -0,0 +1,461 @@
+// -*- C++ -*-
+//
+// Package: FWCore/Services
+// Class  : HardwareCounters
+//
+// Implementation:
+//
+//   Each thread running modules opens its own group of perf_event
+//   counters (cycles, instructions, cache misses, branch misses),
+//   counting only that thread in user space.  The group is read at the
+//   pre and post module signals and the difference is attributed to the
+//   module and to the path it was run for.
+//
+//   When more events are requested than the PMU has counters (e.g. when
+//   other perf users are active) the kernel multiplexes the groups, so the
+//   counts are scaled by the ratio of the time the group was enabled to the
+//   time it actually counted.
+//
+//   A module can run another one on the same thread (unscheduled
+//   production, delayed gets), so the threads keep a stack of running
+//   modules: the counts reported for a module exclude those of the
+//   modules nested into it.
+//
+
+#include "DataFormats/Provenance/interface/ModuleDescription.h"
+#include "FWCore/MessageLogger/interface/MessageLogger.h"
+#include "FWCore/ParameterSet/interface/ConfigurationDescriptions.h"
+#include "FWCore/ParameterSet/interface/ParameterSet.h"
+#include "FWCore/ParameterSet/interface/ParameterSetDescription.h"
+#include "FWCore/ServiceRegistry/interface/ActivityRegistry.h"
+#include "FWCore/ServiceRegistry/interface/ModuleCallingContext.h"
+#include "FWCore/ServiceRegistry/interface/PathContext.h"
+#include "FWCore/ServiceRegistry/interface/PathsAndConsumesOfModulesBase.h"
+#include "FWCore/ServiceRegistry/interface/PlaceInPathContext.h"
+#include "FWCore/ServiceRegistry/interface/ProcessContext.h"
+#include "FWCore/ServiceRegistry/interface/ServiceMaker.h"
+#include "FWCore/ServiceRegistry/interface/StreamContext.h"
+#include "FWCore/Utilities/interface/OStreamColumn.h"
+
+#include "tbb/concurrent_unordered_map.h"
+#include "tbb/enumerable_thread_specific.h"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <fstream>
+#include <iomanip>
+#include <limits>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace {
+
+  enum Counter { kCycles, kInstructions, kCacheMisses, kBranchMisses, kNCounters };
+
+  using Values = std::array<unsigned long long, kNCounters>;
+
+  //===============================================================
+  // The counters of one thread, opened on first use
+  class ThreadCounters {
+  public:
+    ThreadCounters() { fds_.fill(-1); }
+    ~ThreadCounters();
+    ThreadCounters(ThreadCounters const&) = delete;
+    ThreadCounters& operator=(ThreadCounters const&) = delete;
+
+    enum Status { kOk, kUnavailable, kNotRunning };
+
+    // kUnavailable if the counters cannot be used on this thread, kNotRunning
+    // if the kernel never scheduled them on the PMU
+    Status read(Values& oValues, bool iExcludeKernel);
+
+    struct Running {
+      edm::ModuleCallingContext const* mcc;
+      Values start;
+      Values nested;
+    };
+    std::vector<Running> running_;
+
+  private:
+    bool open(bool iExcludeKernel);
+    void close();
+
+    std::array<int, kNCounters> fds_;
+    bool tried_ = false;
+  };
+
+#ifdef __linux__
+  int openCounter(unsigned long long iConfig, int iGroup, bool iExcludeKernel) {
+    perf_event_attr attr;
+    std::fill(reinterpret_cast<char*>(&attr), reinterpret_cast<char*>(&attr) + sizeof(attr), 0);
+    attr.type = PERF_TYPE_HARDWARE;
+    attr.size = sizeof(attr);
+    attr.config = iConfig;
+    attr.read_format = PERF_FORMAT_GROUP | PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+    attr.exclude_kernel = iExcludeKernel ? 1 : 0;
+    attr.exclude_hv = 1;
+    // pid 0 and cpu -1: only the calling thread, on whatever cpu it runs
+    return syscall(__NR_perf_event_open, &attr, 0, -1, iGroup, 0);
+  }
+
+  bool ThreadCounters::open(bool iExcludeKernel) {
+    static unsigned long long const configs[kNCounters] = {PERF_COUNT_HW_CPU_CYCLES,
+                                                           PERF_COUNT_HW_INSTRUCTIONS,
+                                                           PERF_COUNT_HW_CACHE_MISSES,
+                                                           PERF_COUNT_HW_BRANCH_MISSES};
+    for (unsigned int i = 0; i != kNCounters; ++i) {
+      fds_[i] = openCounter(configs[i], i == 0 ? -1 : fds_[0], iExcludeKernel);
+      if (fds_[i] < 0) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  ThreadCounters::Status ThreadCounters::read(Values& oValues, bool iExcludeKernel) {
+    if (not tried_) {
+      tried_ = true;
+      if (not open(iExcludeKernel)) {
+        close();
+      }
+    }
+    if (fds_[0] < 0) {
+      return kUnavailable;
+    }
+    struct {
+      unsigned long long nr;
+      unsigned long long timeEnabled;
+      unsigned long long timeRunning;
+      unsigned long long values[kNCounters];
+    } data;
+    if (::read(fds_[0], &data, sizeof(data)) != static_cast<ssize_t>(sizeof(data)) || data.nr != kNCounters) {
+      return kUnavailable;
+    }
+    if (data.timeRunning == 0) {
+      return kNotRunning;
+    }
+    // the estimate of what would have been counted without multiplexing
+    double const scale = static_cast<double>(data.timeEnabled) / data.timeRunning;
+    for (unsigned int i = 0; i != kNCounters; ++i) {
+      oValues[i] = data.timeEnabled == data.timeRunning ? data.values[i]
+                                                        : static_cast<unsigned long long>(data.values[i] * scale);
+    }
+    return kOk;
+  }
+
+  void ThreadCounters::close() {
+    for (auto& fd : fds_) {
+      if (fd >= 0) {
+        ::close(fd);
+      }
+      fd = -1;
+    }
+  }
+#else
+  bool ThreadCounters::open(bool) { return false; }
+  ThreadCounters::Status ThreadCounters::read(Values&, bool) { return kUnavailable; }
+  void ThreadCounters::close() {}
+#endif
+
+  ThreadCounters::~ThreadCounters() { close(); }
+
+  //===============================================================
+  class Counts {
+  public:
+    Counts() {
+      for (auto& v : values_) {
+        v = 0;
+      }
+    }
+    Counts(Counts const& iOther) : calls_(iOther.calls_.load()) {
+      for (unsigned int i = 0; i != kNCounters; ++i) {
+        values_[i] = iOther.values_[i].load();
+      }
+    }
+
+    void add(Values const& iValues) {
+      ++calls_;
+      for (unsigned int i = 0; i != kNCounters; ++i) {
+        values_[i] += iValues[i];
+      }
+    }
+    void add(Counts const& iOther) {
+      calls_ += iOther.calls_.load();
+      for (unsigned int i = 0; i != kNCounters; ++i) {
+        values_[i] += iOther.values_[i].load();
+      }
+    }
+
+    unsigned long long calls() const { return calls_; }
+    unsigned long long value(Counter iCounter) const { return values_[iCounter]; }
+
+  private:
+    std::atomic<unsigned long long> calls_{0};
+    std::array<std::atomic<unsigned long long>, kNCounters> values_;
+  };
+
+  std::string const space{"  "};
+  constexpr unsigned int kNoPath = std::numeric_limits<unsigned int>::max();
+
+  unsigned long long countsKey(unsigned int iPathSlot, unsigned int iModuleID) {
+    return (static_cast<unsigned long long>(iPathSlot) << 32) | iModuleID;
+  }
+  unsigned int pathSlotOf(unsigned long long iKey) { return iKey >> 32; }
+  unsigned int moduleIDOf(unsigned long long iKey) { return iKey & 0xffffffffULL; }
+
+}  // namespace
+
+namespace edm {
+  namespace service {
+
+    class HardwareCounters {
+    public:
+      HardwareCounters(ParameterSet const&, ActivityRegistry&);
+      static void fillDescriptions(edm::ConfigurationDescriptions& descriptions);
+
+    private:
+      void preBeginJob(PathsAndConsumesOfModulesBase const&, ProcessContext const&);
+      void preModule(StreamContext const&, ModuleCallingContext const&);
+      void postModule(StreamContext const&, ModuleCallingContext const&);
+      void postEndJob();
+
+      unsigned int pathSlot(StreamContext const&, ModuleCallingContext const&) const;
+      void warn(ThreadCounters::Status);
+      void printSummary() const;
+      void writeFlameGraph() const;
+
+      std::string const flameGraphFile_;
+      bool const excludeKernel_;
+
+      tbb::enumerable_thread_specific<ThreadCounters> threads_;
+      std::atomic<bool> warnedUnavailable_{false};
+      std::atomic<bool> warnedNotRunning_{false};
+
+      // trigger paths first, then end paths
+      std::vector<std::string> pathNames_;
+      unsigned int nTriggerPaths_ = 0;
+      std::vector<std::string> moduleLabels_;
+      // counts of each module, per path (kNoPath when the module was not
+      // run as part of a path, e.g. unscheduled), see countsKey
+      tbb::concurrent_unordered_map<unsigned long long, Counts> counts_;
+    };
+
+  }  // namespace service
+}  // namespace edm
+
+using edm::service::HardwareCounters;
+
+HardwareCounters::HardwareCounters(ParameterSet const& iPS, ActivityRegistry& iRegistry)
+    : flameGraphFile_{iPS.getUntrackedParameter<std::string>("flameGraphFile")},
+      excludeKernel_{iPS.getUntrackedParameter<bool>("excludeKernel")} {
+  iRegistry.watchPreBeginJob(this, &HardwareCounters::preBeginJob);
+  iRegistry.watchPreModuleEventAcquire(this, &HardwareCounters::preModule);
+  iRegistry.watchPostModuleEventAcquire(this, &HardwareCounters::postModule);
+  iRegistry.watchPreModuleEvent(this, &HardwareCounters::preModule);
+  iRegistry.watchPostModuleEvent(this, &HardwareCounters::postModule);
+  iRegistry.watchPostEndJob(this, &HardwareCounters::postEndJob);
+}
+
+void HardwareCounters::fillDescriptions(ConfigurationDescriptions& descriptions) {
+  ParameterSetDescription desc;
+  desc.addUntracked<std::string>("flameGraphFile", "")
+      ->setComment(
+          "Name of the file to which the cycles spent in each module are written, in the 'folded' format\n"
+          "read by flamegraph.pl (one 'cmsRun;path;module cycles' line per module and path).\n"
+          "An empty name (the default) means no file is written.");
+  desc.addUntracked<bool>("excludeKernel", true)
+      ->setComment(
+          "Count only what happens in user space. Counting the kernel as well usually requires\n"
+          "/proc/sys/kernel/perf_event_paranoid to be lower than 2.");
+  descriptions.add("HardwareCounters", desc);
+  descriptions.setComment(
+      "This service reads the cpu hardware counters (cycles, instructions, cache misses, branch misses) around "
+      "each module and reports them per module and per path.");
+}
+
+void HardwareCounters::preBeginJob(PathsAndConsumesOfModulesBase const& iPnC, ProcessContext const& iPC) {
+  // module ids are unique across the SubProcesses, path ids are not: the
+  // modules of the SubProcesses are reported without their paths
+  if (not iPC.isSubProcess()) {
+    pathNames_ = iPnC.paths();
+    nTriggerPaths_ = pathNames_.size();
+    pathNames_.insert(pathNames_.end(), iPnC.endPaths().begin(), iPnC.endPaths().end());
+  }
+  for (auto const* md : iPnC.allModules()) {
+    if (md->id() >= moduleLabels_.size()) {
+      moduleLabels_.resize(md->id() + 1);
+    }
+    moduleLabels_[md->id()] = md->moduleLabel();
+  }
+}
+
+unsigned int HardwareCounters::pathSlot(StreamContext const& iSC, ModuleCallingContext const& iMCC) const {
+  auto const* place = iMCC.placeInPathContext();
+  if (place == nullptr or iSC.processContext()->isSubProcess()) {
+    return kNoPath;
+  }
+  auto const* path = place->pathContext();
+  return path->isEndPath() ? nTriggerPaths_ + path->pathID() : path->pathID();
+}
+
+void HardwareCounters::preModule(StreamContext const&, ModuleCallingContext const& iMCC) {
+  auto& thread = threads_.local();
+  ThreadCounters::Running running;
+  auto const status = thread.read(running.start, excludeKernel_);
+  if (status != ThreadCounters::kOk) {
+    warn(status);
+    return;
+  }
+  running.mcc = &iMCC;
+  running.nested.fill(0);
+  thread.running_.push_back(running);
+}
+
+void HardwareCounters::warn(ThreadCounters::Status iStatus) {
+  if (iStatus == ThreadCounters::kUnavailable) {
+    if (not warnedUnavailable_.exchange(true)) {
+      edm::LogWarning("HardwareCounters")
+          << "The hardware counters cannot be read, no counts will be reported for the modules run by some threads.\n"
+             "Check the value of /proc/sys/kernel/perf_event_paranoid: counting the user space requires at most 2,\n"
+             "counting the kernel as well (excludeKernel false) at most 1. Virtual machines and containers may not\n"
+             "give access to the PMU at all.";
+    }
+  } else if (iStatus == ThreadCounters::kNotRunning) {
+    if (not warnedNotRunning_.exchange(true)) {
+      edm::LogWarning("HardwareCounters")
+          << "The hardware counters were never scheduled on the PMU (time running is 0), no counts will be reported\n"
+             "for some modules. Another perf user (e.g. the NMI watchdog or a running 'perf') may be holding the\n"
+             "hardware counters.";
+    }
+  }
+}
+
+void HardwareCounters::postModule(StreamContext const& iSC, ModuleCallingContext const& iMCC) {
+  auto& thread = threads_.local();
+  if (thread.running_.empty() or thread.running_.back().mcc != &iMCC) {
+    return;
+  }
+  Values now;
+  auto const status = thread.read(now, excludeKernel_);
+  auto const running = thread.running_.back();
+  thread.running_.pop_back();
+  if (status != ThreadCounters::kOk) {
+    warn(status);
+    return;
+  }
+  Values own;
+  for (unsigned int i = 0; i != kNCounters; ++i) {
+    // the scaled counts of a multiplexed group can decrease a little
+    auto const total = now[i] > running.start[i] ? now[i] - running.start[i] : 0;
+    own[i] = total > running.nested[i] ? total - running.nested[i] : 0;
+    if (not thread.running_.empty()) {
+      thread.running_.back().nested[i] += total;
+    }
+  }
+  counts_[countsKey(pathSlot(iSC, iMCC), iMCC.moduleDescription()->id())].add(own);
+}
+
+void HardwareCounters::postEndJob() {
+  printSummary();
+  if (not flameGraphFile_.empty()) {
+    writeFlameGraph();
+  }
+}
+
+void HardwareCounters::printSummary() const {
+  std::vector<Counts> modules(moduleLabels_.size());
+  std::vector<Counts> paths(pathNames_.size());
+  for (auto const& entry : counts_) {
+    if (moduleIDOf(entry.first) >= modules.size()) {
+      continue;
+    }
+    modules[moduleIDOf(entry.first)].add(entry.second);
+    if (pathSlotOf(entry.first) != kNoPath) {
+      paths[pathSlotOf(entry.first)].add(entry.second);
+    }
+  }
+
+  // instructions per cycle, and misses per thousand instructions: a low IPC
+  // with many cache misses points to a memory bound module
+  auto ratio = [](unsigned long long iNum, unsigned long long iDen, double iScale) {
+    std::ostringstream oss;
+    oss << std::fixed << std::setprecision(2) << (iDen == 0 ? 0. : iScale * iNum / iDen);
+    return oss.str();
+  };
+
+  auto print = [&](LogAbsolute& out, std::string const& iTitle, std::vector<std::string> const& iNames,
+                   std::vector<Counts> const& iCounts) {
+    std::size_t width = iTitle.size();
+    for (std::size_t i = 0; i < iNames.size(); ++i) {
+      if (iCounts[i].calls() != 0) {
+        width = std::max(width, iNames[i].size());
+      }
+    }
+    OStreamColumn tag{"HardwareCounters>"};
+    OStreamColumn col1{iTitle, width};
+    OStreamColumn col2{"Calls"};
+    OStreamColumn col3{"Cycles", 16};
+    OStreamColumn col4{"Instructions", 16};
+    OStreamColumn col5{"IPC"};
+    OStreamColumn col6{"Cache MPKI"};
+    OStreamColumn col7{"Branch MPKI"};
+
+    out << '\n'
+        << tag << space << col1 << space << col2 << space << col3 << space << col4 << space << col5 << space << col6
+        << space << col7 << '\n';
+    out << tag << space << std::setfill('-') << col1(std::string{}) << space << col2(std::string{}) << space
+        << col3(std::string{}) << space << col4(std::string{}) << space << col5(std::string{}) << space
+        << col6(std::string{}) << space << col7(std::string{}) << '\n';
+    out << std::setfill(' ');
+    for (std::size_t i = 0; i < iNames.size(); ++i) {
+      auto const& c = iCounts[i];
+      if (c.calls() == 0) {
+        continue;
+      }
+      out << std::left << tag << space << col1(iNames[i]) << space << std::right << col2(c.calls()) << space
+          << col3(c.value(kCycles)) << space << col4(c.value(kInstructions)) << space
+          << col5(ratio(c.value(kInstructions), c.value(kCycles), 1.)) << space
+          << col6(ratio(c.value(kCacheMisses), c.value(kInstructions), 1000.)) << space
+          << col7(ratio(c.value(kBranchMisses), c.value(kInstructions), 1000.)) << '\n';
+    }
+  };
+
+  LogAbsolute out{"HardwareCounters"};
+  print(out, "Module label", moduleLabels_, modules);
+  print(out, "Path", pathNames_, paths);
+}
+
+void HardwareCounters::writeFlameGraph() const {
+  // sorted, so that the file does not depend on the order the modules ran in
+  std::map<std::string, unsigned long long> stacks;
+  for (auto const& entry : counts_) {
+    if (moduleIDOf(entry.first) >= moduleLabels_.size()) {
+      continue;
+    }
+    std::string stack = "cmsRun;";
+    auto const slot = pathSlotOf(entry.first);
+    stack += slot == kNoPath ? std::string("unscheduled") : pathNames_[slot];
+    stack += ';';
+    stack += moduleLabels_[moduleIDOf(entry.first)];
+    stacks[stack] += entry.second.value(kCycles);
+  }
+  std::ofstream file(flameGraphFile_);
+  for (auto const& stack : stacks) {
+    file << stack.first << ' ' << stack.second << '\n';
+  }
+  if (not file) {
+    edm::LogWarning("HardwareCounters") << "Could not write the flame graph file " << flameGraphFile_;
+  }
+}
+
+DEFINE_FWK_SERVICE(HardwareCounters);
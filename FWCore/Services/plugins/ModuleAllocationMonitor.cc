@@ -0,0 +1,497 @@
+// -*- C++ -*-
+//
+// Package: FWCore/Services
+// Class  : ModuleAllocationMonitor
+//
+// Implementation:
+//
+//   The allocations are seen through the hooks of jemalloc (5.1 or later,
+//   the allocator used by cmsRun), installed at run time with mallctl
+//   like the thread statistics read by the FastTimerService. The hooks
+//   see every allocation and deallocation of the process and account
+//   them to the module the calling thread is running, if any; jemalloc
+//   does not call them again for the allocations made within a hook.
+//
+//   Every sampleBytes allocated bytes on a thread, the call stack of the
+//   allocation is recorded, so the call sites found are weighted by the
+//   number of bytes they allocate.  The stacks are only symbolized at
+//   the end of the job.
+//
+//   The peak of a module call is the highest value reached by the bytes
+//   allocated minus the bytes freed on the thread during that call; what
+//   is left at the end of the call is reported as retained.
+//
+
+#include "DataFormats/Provenance/interface/ModuleDescription.h"
+#include "FWCore/MessageLogger/interface/MessageLogger.h"
+#include "FWCore/ParameterSet/interface/ConfigurationDescriptions.h"
+#include "FWCore/ParameterSet/interface/ParameterSet.h"
+#include "FWCore/ParameterSet/interface/ParameterSetDescription.h"
+#include "FWCore/ServiceRegistry/interface/ActivityRegistry.h"
+#include "FWCore/ServiceRegistry/interface/ModuleCallingContext.h"
+#include "FWCore/ServiceRegistry/interface/ServiceMaker.h"
+#include "FWCore/ServiceRegistry/interface/StreamContext.h"
+#include "FWCore/Utilities/interface/OStreamColumn.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <cxxabi.h>
+#include <dlfcn.h>
+#include <execinfo.h>
+#include <malloc.h>
+
+// see <jemalloc/jemalloc.h>
+extern "C" {
+typedef int (*mallctl_t)(const char* name, void* oldp, size_t* oldlenp, void* newp, size_t newlen);
+typedef void (*hook_alloc)(void* extra, int type, void* result, uintptr_t result_raw, uintptr_t args_raw[3]);
+typedef void (*hook_dalloc)(void* extra, int type, void* address, uintptr_t args_raw[3]);
+typedef void (*hook_expand)(
+    void* extra, int type, void* address, size_t old_usize, size_t new_usize, uintptr_t result_raw, uintptr_t args_raw[4]);
+struct hooks_t {
+  hook_alloc alloc_hook;
+  hook_dalloc dalloc_hook;
+  hook_expand expand_hook;
+  void* extra;
+};
+}
+
+namespace {
+
+  constexpr unsigned int kMaxDepth = 32;
+
+  //===============================================================
+  class ModuleStats {
+  public:
+    void addCall(unsigned long long iAllocs,
+                 unsigned long long iAllocated,
+                 unsigned long long iFrees,
+                 unsigned long long iFreed,
+                 long long iPeak,
+                 long long iRetained) {
+      ++calls_;
+      allocs_ += iAllocs;
+      allocated_ += iAllocated;
+      frees_ += iFrees;
+      freed_ += iFreed;
+      retained_ += iRetained;
+      long long max = maxPeak_;
+      while (iPeak > max && !maxPeak_.compare_exchange_weak(max, iPeak))
+        ;
+    }
+
+    unsigned long long calls() const { return calls_; }
+    unsigned long long allocs() const { return allocs_; }
+    unsigned long long allocated() const { return allocated_; }
+    unsigned long long frees() const { return frees_; }
+    unsigned long long freed() const { return freed_; }
+    long long maxPeak() const { return maxPeak_; }
+    long long retained() const { return retained_; }
+
+  private:
+    std::atomic<unsigned long long> calls_{0};
+    std::atomic<unsigned long long> allocs_{0};
+    std::atomic<unsigned long long> allocated_{0};
+    std::atomic<unsigned long long> frees_{0};
+    std::atomic<unsigned long long> freed_{0};
+    std::atomic<long long> maxPeak_{0};
+    std::atomic<long long> retained_{0};
+  };
+
+  // what a thread accounts to the module calls it is running
+  struct Running {
+    edm::ModuleCallingContext const* mcc;
+    unsigned int moduleID;
+    unsigned long long allocs;
+    unsigned long long allocated;
+    unsigned long long frees;
+    unsigned long long freed;
+    long long live;
+    long long peak;
+  };
+
+  struct ThreadState {
+    std::vector<Running> running;
+    long long untilSample;
+  };
+
+  // The hooks run for any allocation of any thread, also after the thread_local
+  // objects are destroyed: only trivial thread_locals are used, and the states
+  // belong to the service. The generation tells if the state is the one of the
+  // current service instance.
+  thread_local ThreadState* t_state = nullptr;
+  thread_local unsigned int t_generation = 0;
+  std::atomic<unsigned int> s_generation{0};
+
+  std::string const space{"  "};
+
+  std::string toKB(long long iBytes) {
+    std::ostringstream oss;
+    oss << std::fixed << std::setprecision(1) << iBytes / 1024.;
+    return oss.str();
+  }
+
+  std::string toMB(unsigned long long iBytes) {
+    std::ostringstream oss;
+    oss << std::fixed << std::setprecision(1) << iBytes / (1024. * 1024.);
+    return oss.str();
+  }
+
+  std::string frameName(void* iAddress) {
+    Dl_info info;
+    if (dladdr(iAddress, &info) == 0) {
+      std::ostringstream oss;
+      oss << iAddress;
+      return oss.str();
+    }
+    if (info.dli_sname != nullptr) {
+      int status = 0;
+      char* demangled = abi::__cxa_demangle(info.dli_sname, nullptr, nullptr, &status);
+      std::string name = (status == 0 and demangled != nullptr) ? demangled : info.dli_sname;
+      free(demangled);
+      return name;
+    }
+    std::ostringstream oss;
+    oss << (info.dli_fname != nullptr ? info.dli_fname : "?") << "+0x" << std::hex
+        << (static_cast<char*>(iAddress) - static_cast<char*>(info.dli_fbase));
+    return oss.str();
+  }
+
+  std::string libraryOf(void const* iAddress) {
+    Dl_info info;
+    if (dladdr(iAddress, &info) == 0 or info.dli_fname == nullptr) {
+      return std::string();
+    }
+    return info.dli_fname;
+  }
+
+}  // namespace
+
+namespace edm {
+  namespace service {
+
+    class ModuleAllocationMonitor {
+    public:
+      ModuleAllocationMonitor(ParameterSet const&, ActivityRegistry&);
+      ~ModuleAllocationMonitor();
+      static void fillDescriptions(edm::ConfigurationDescriptions& descriptions);
+
+    private:
+      void preModuleConstruction(ModuleDescription const&);
+      void postBeginJob();
+      void preModule(StreamContext const&, ModuleCallingContext const&);
+      void postModule(StreamContext const&, ModuleCallingContext const&);
+      void postEndJob();
+
+      static void allocHook(void* extra, int type, void* result, uintptr_t result_raw, uintptr_t args_raw[3]);
+      static void dallocHook(void* extra, int type, void* address, uintptr_t args_raw[3]);
+      static void expandHook(void* extra,
+                             int type,
+                             void* address,
+                             size_t old_usize,
+                             size_t new_usize,
+                             uintptr_t result_raw,
+                             uintptr_t args_raw[4]);
+
+      void allocated(size_t iSize);
+      void freed(size_t iSize);
+      void sample(unsigned int iModuleID);
+      void printSummary() const;
+
+      unsigned long long const sampleBytes_;
+      unsigned int const stackDepth_;
+      unsigned int const nCallSites_;
+
+      mallctl_t mallctl_ = nullptr;
+      void* hooksHandle_ = nullptr;
+      unsigned int generation_;
+
+      std::vector<std::string> moduleLabels_;
+      std::unique_ptr<ModuleStats[]> moduleStats_;
+      unsigned int nModuleStats_ = 0;
+
+      std::mutex statesMutex_;
+      std::vector<std::unique_ptr<ThreadState>> states_;
+
+      // sampled call stacks of each module, and the number of samples
+      std::mutex samplesMutex_;
+      std::map<std::pair<unsigned int, std::vector<void*>>, unsigned long long> samples_;
+    };
+
+  }  // namespace service
+}  // namespace edm
+
+using edm::service::ModuleAllocationMonitor;
+
+ModuleAllocationMonitor::ModuleAllocationMonitor(ParameterSet const& iPS, ActivityRegistry& iRegistry)
+    : sampleBytes_{iPS.getUntrackedParameter<unsigned long long>("sampleBytes")},
+      stackDepth_{std::min(iPS.getUntrackedParameter<unsigned int>("stackDepth"), kMaxDepth)},
+      nCallSites_{iPS.getUntrackedParameter<unsigned int>("nCallSites")},
+      generation_{++s_generation} {
+  mallctl_ = reinterpret_cast<mallctl_t>(::dlsym(RTLD_DEFAULT, "mallctl"));
+  hooks_t hooks{&ModuleAllocationMonitor::allocHook,
+                &ModuleAllocationMonitor::dallocHook,
+                &ModuleAllocationMonitor::expandHook,
+                this};
+  size_t handleSize = sizeof(hooksHandle_);
+  if (mallctl_ == nullptr or
+      mallctl_("experimental.hooks.install", &hooksHandle_, &handleSize, &hooks, sizeof(hooks)) != 0) {
+    hooksHandle_ = nullptr;
+    edm::LogWarning("ModuleAllocationMonitor")
+        << "The allocation hooks of jemalloc (version 5.1 or later) are not available, "
+           "no allocation will be reported.";
+    return;
+  }
+  if (sampleBytes_ != 0) {
+    // the first call of backtrace loads the unwinder, do it before any hook needs it
+    void* frames[2];
+    backtrace(frames, 2);
+  }
+
+  iRegistry.watchPreModuleConstruction(this, &ModuleAllocationMonitor::preModuleConstruction);
+  iRegistry.watchPostBeginJob(this, &ModuleAllocationMonitor::postBeginJob);
+  iRegistry.watchPreModuleEventAcquire(this, &ModuleAllocationMonitor::preModule);
+  iRegistry.watchPostModuleEventAcquire(this, &ModuleAllocationMonitor::postModule);
+  iRegistry.watchPreModuleEvent(this, &ModuleAllocationMonitor::preModule);
+  iRegistry.watchPostModuleEvent(this, &ModuleAllocationMonitor::postModule);
+  iRegistry.watchPostEndJob(this, &ModuleAllocationMonitor::postEndJob);
+}
+
+ModuleAllocationMonitor::~ModuleAllocationMonitor() {
+  if (hooksHandle_ != nullptr) {
+    mallctl_("experimental.hooks.remove", nullptr, nullptr, &hooksHandle_, sizeof(hooksHandle_));
+  }
+}
+
+void ModuleAllocationMonitor::fillDescriptions(ConfigurationDescriptions& descriptions) {
+  ParameterSetDescription desc;
+  desc.addUntracked<unsigned long long>("sampleBytes", 1024 * 1024)
+      ->setComment(
+          "The call stack of an allocation is recorded every 'sampleBytes' bytes allocated by a thread.\n"
+          "0 disables the call site report.");
+  desc.addUntracked<unsigned int>("stackDepth", 16)
+      ->setComment("Number of frames recorded for each sample (at most 32).");
+  desc.addUntracked<unsigned int>("nCallSites", 5)->setComment("Number of call sites reported for each module.");
+  descriptions.add("ModuleAllocationMonitor", desc);
+  descriptions.setComment(
+      "This service reports, for each module, the memory allocated and freed while the module runs, the peak "
+      "and retained memory of its calls, and the call sites which allocate the most. It requires jemalloc.");
+}
+
+void ModuleAllocationMonitor::preModuleConstruction(ModuleDescription const& iDesc) {
+  if (iDesc.id() >= moduleLabels_.size()) {
+    moduleLabels_.resize(iDesc.id() + 1);
+  }
+  moduleLabels_[iDesc.id()] = iDesc.moduleLabel();
+}
+
+void ModuleAllocationMonitor::postBeginJob() {
+  nModuleStats_ = moduleLabels_.size();
+  moduleStats_.reset(new ModuleStats[nModuleStats_]);
+}
+
+void ModuleAllocationMonitor::preModule(StreamContext const&, ModuleCallingContext const& iMCC) {
+  auto const id = iMCC.moduleDescription()->id();
+  if (id >= nModuleStats_) {
+    return;
+  }
+  if (t_generation != generation_) {
+    auto state = std::make_unique<ThreadState>();
+    state->untilSample = sampleBytes_;
+    // reserved so that the hooks never see the vector being reallocated
+    state->running.reserve(64);
+    {
+      std::lock_guard<std::mutex> guard(statesMutex_);
+      states_.push_back(std::move(state));
+      t_state = states_.back().get();
+    }
+    t_generation = generation_;
+  }
+  if (t_state->running.size() == t_state->running.capacity()) {
+    return;
+  }
+  t_state->running.push_back(Running{&iMCC, id, 0, 0, 0, 0, 0, 0});
+}
+
+void ModuleAllocationMonitor::postModule(StreamContext const&, ModuleCallingContext const& iMCC) {
+  if (t_generation != generation_ or t_state->running.empty() or t_state->running.back().mcc != &iMCC) {
+    return;
+  }
+  Running const running = t_state->running.back();
+  t_state->running.pop_back();
+  moduleStats_[running.moduleID].addCall(
+      running.allocs, running.allocated, running.frees, running.freed, running.peak, running.live);
+  if (not t_state->running.empty()) {
+    // the memory of a nested module call also counts for the calling module
+    auto& caller = t_state->running.back();
+    caller.peak = std::max(caller.peak, caller.live + running.peak);
+    caller.live += running.live;
+  }
+}
+
+void ModuleAllocationMonitor::allocated(size_t iSize) {
+  if (t_generation != generation_ or t_state->running.empty()) {
+    return;
+  }
+  auto& running = t_state->running.back();
+  ++running.allocs;
+  running.allocated += iSize;
+  running.live += iSize;
+  running.peak = std::max(running.peak, running.live);
+  if (sampleBytes_ != 0) {
+    t_state->untilSample -= iSize;
+    if (t_state->untilSample <= 0) {
+      t_state->untilSample += sampleBytes_;
+      if (t_state->untilSample <= 0) {
+        t_state->untilSample = sampleBytes_;
+      }
+      sample(running.moduleID);
+    }
+  }
+}
+
+void ModuleAllocationMonitor::freed(size_t iSize) {
+  if (t_generation != generation_ or t_state->running.empty()) {
+    return;
+  }
+  auto& running = t_state->running.back();
+  ++running.frees;
+  running.freed += iSize;
+  running.live -= iSize;
+}
+
+void ModuleAllocationMonitor::sample(unsigned int iModuleID) {
+  void* frames[kMaxDepth];
+  int const depth = backtrace(frames, stackDepth_);
+  std::vector<void*> stack(frames, frames + depth);
+  std::lock_guard<std::mutex> guard(samplesMutex_);
+  ++samples_[std::make_pair(iModuleID, std::move(stack))];
+}
+
+void ModuleAllocationMonitor::allocHook(void* extra, int, void* result, uintptr_t, uintptr_t*) {
+  if (result != nullptr) {
+    static_cast<ModuleAllocationMonitor*>(extra)->allocated(malloc_usable_size(result));
+  }
+}
+
+void ModuleAllocationMonitor::dallocHook(void* extra, int, void* address, uintptr_t*) {
+  // called before the memory is released, so its size can still be asked
+  if (address != nullptr) {
+    static_cast<ModuleAllocationMonitor*>(extra)->freed(malloc_usable_size(address));
+  }
+}
+
+void ModuleAllocationMonitor::expandHook(
+    void* extra, int, void*, size_t old_usize, size_t new_usize, uintptr_t, uintptr_t*) {
+  auto* monitor = static_cast<ModuleAllocationMonitor*>(extra);
+  if (new_usize > old_usize) {
+    monitor->allocated(new_usize - old_usize);
+  } else if (new_usize < old_usize) {
+    monitor->freed(old_usize - new_usize);
+  }
+}
+
+void ModuleAllocationMonitor::postEndJob() {
+  if (hooksHandle_ != nullptr) {
+    mallctl_("experimental.hooks.remove", nullptr, nullptr, &hooksHandle_, sizeof(hooksHandle_));
+    hooksHandle_ = nullptr;
+  }
+  printSummary();
+}
+
+void ModuleAllocationMonitor::printSummary() const {
+  std::size_t width = std::string("Module label").size();
+  for (unsigned int i = 0; i < nModuleStats_; ++i) {
+    if (moduleStats_[i].calls() != 0) {
+      width = std::max(width, moduleLabels_[i].size());
+    }
+  }
+
+  OStreamColumn tag{"ModuleAllocationMonitor>"};
+  OStreamColumn col1{"Module label", width};
+  OStreamColumn col2{"Calls"};
+  OStreamColumn col3{"Allocations", 12};
+  OStreamColumn col4{"Allocated (MB)"};
+  OStreamColumn col5{"Frees", 12};
+  OStreamColumn col6{"Freed (MB)"};
+  OStreamColumn col7{"Max peak/call (kB)"};
+  OStreamColumn col8{"Mean retained/call (kB)"};
+
+  LogAbsolute out{"ModuleAllocationMonitor"};
+  out << '\n'
+      << tag << space << col1 << space << col2 << space << col3 << space << col4 << space << col5 << space << col6
+      << space << col7 << space << col8 << '\n';
+  out << tag << space << std::setfill('-') << col1(std::string{}) << space << col2(std::string{}) << space
+      << col3(std::string{}) << space << col4(std::string{}) << space << col5(std::string{}) << space
+      << col6(std::string{}) << space << col7(std::string{}) << space << col8(std::string{}) << '\n';
+  out << std::setfill(' ');
+  for (unsigned int i = 0; i < nModuleStats_; ++i) {
+    auto const& stats = moduleStats_[i];
+    if (stats.calls() == 0) {
+      continue;
+    }
+    out << std::left << tag << space << col1(moduleLabels_[i]) << space << std::right << col2(stats.calls()) << space
+        << col3(stats.allocs()) << space << col4(toMB(stats.allocated())) << space << col5(stats.frees()) << space
+        << col6(toMB(stats.freed())) << space << col7(toKB(stats.maxPeak())) << space
+        << col8(toKB(stats.retained() / static_cast<long long>(stats.calls()))) << '\n';
+  }
+
+  if (samples_.empty()) {
+    return;
+  }
+
+  // the first frames are those of the hooks and of the allocator
+  void const* operatorNew = reinterpret_cast<void const*>(static_cast<void* (*)(std::size_t)>(&::operator new));
+  std::vector<std::string> const allocatorLibraries{
+      libraryOf(reinterpret_cast<void const*>(&ModuleAllocationMonitor::allocHook)),
+      libraryOf(reinterpret_cast<void const*>(mallctl_)),
+      libraryOf(operatorNew)};
+  auto firstUserFrame = [&](std::vector<void*> const& iStack) {
+    auto frame = iStack.begin();
+    while (frame != iStack.end()) {
+      auto const library = libraryOf(*frame);
+      if (library.empty() or
+          std::find(allocatorLibraries.begin(), allocatorLibraries.end(), library) == allocatorLibraries.end()) {
+        break;
+      }
+      ++frame;
+    }
+    return frame;
+  };
+
+  // call sites, from the allocating function up the stack, with their number of samples, per module
+  std::map<unsigned int, std::map<std::vector<void*>, unsigned long long>> sites;
+  for (auto const& sample : samples_) {
+    auto const& stack = sample.first.second;
+    std::vector<void*> site(firstUserFrame(stack), stack.end());
+    sites[sample.first.first][site] += sample.second;
+  }
+
+  out << "\nModuleAllocationMonitor> Call sites allocating the most, estimated from one sample every " << sampleBytes_
+      << " bytes\n";
+  for (auto const& module : sites) {
+    std::vector<std::pair<unsigned long long, std::vector<void*> const*>> ordered;
+    for (auto const& site : module.second) {
+      ordered.emplace_back(site.second, &site.first);
+    }
+    std::sort(ordered.begin(), ordered.end(), [](auto const& a, auto const& b) { return a.first > b.first; });
+    out << "\nModuleAllocationMonitor> " << moduleLabels_[module.first] << '\n';
+    for (unsigned int i = 0; i < ordered.size() and i < nCallSites_; ++i) {
+      out << "  ~" << toMB(ordered[i].first * sampleBytes_) << " MB\n";
+      for (auto const* frame : *ordered[i].second) {
+        out << "      " << frameName(const_cast<void*>(frame)) << '\n';
+      }
+    }
+  }
+}
+
+DEFINE_FWK_SERVICE(ModuleAllocationMonitor);
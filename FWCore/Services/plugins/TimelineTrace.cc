@@ -0,0 +1,376 @@
+// -*- C++ -*-
+//
+// Package: FWCore/Services
+// Class  : TimelineTrace
+//
+// Implementation:
+//
+//   Every begin and end of the source, module, EventSetup and transition
+//   activities is recorded as a fixed size binary record in a buffer
+//   owned by the thread which saw it, so recording takes no lock. Full
+//   buffers are handed to a ThreadSafeOutputFileStream, and are written
+//   to the file by the calling thread: a thread finding the file busy
+//   only queues its buffer, which is then written by the busy thread.
+//   The bufferSize parameter trades the memory used for how often a
+//   thread is stopped by a write.  Names (modules, EventSetup
+//   components) are written once, as they are first needed.
+//
+//   The file is converted to the Chrome trace / Perfetto JSON format
+//   with edmTimelineTraceToJSON.py, which also documents the layout.
+//
+
+#include "DataFormats/Provenance/interface/ModuleDescription.h"
+#include "FWCore/Concurrency/interface/ThreadSafeOutputFileStream.h"
+#include "FWCore/Framework/interface/ComponentDescription.h"
+#include "FWCore/Framework/interface/DataKey.h"
+#include "FWCore/Framework/interface/EventSetupRecordKey.h"
+#include "FWCore/MessageLogger/interface/MessageLogger.h"
+#include "FWCore/ParameterSet/interface/ConfigurationDescriptions.h"
+#include "FWCore/ParameterSet/interface/ParameterSet.h"
+#include "FWCore/ParameterSet/interface/ParameterSetDescription.h"
+#include "FWCore/ServiceRegistry/interface/ActivityRegistry.h"
+#include "FWCore/ServiceRegistry/interface/GlobalContext.h"
+#include "FWCore/ServiceRegistry/interface/ModuleCallingContext.h"
+#include "FWCore/ServiceRegistry/interface/ServiceMaker.h"
+#include "FWCore/ServiceRegistry/interface/StreamContext.h"
+#include "FWCore/ServiceRegistry/interface/SystemBounds.h"
+
+#include "tbb/enumerable_thread_specific.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace {
+
+  using clock_type = std::chrono::steady_clock;
+
+  // The values below are part of the file format, keep in sync with edmTimelineTraceToJSON.py
+  char const magic[8] = {'E', 'D', 'M', 'T', 'L', 'V', '0', '1'};
+
+  enum class Block : std::uint32_t { records = 1, name = 2 };
+
+  enum class Activity : std::uint8_t { source = 0, module = 1, moduleAcquire = 2, transition = 3, esProduce = 4, esLock = 5 };
+
+  enum class Transition : std::uint16_t {
+    event = 0,
+    streamBeginRun = 1,
+    streamBeginLumi = 2,
+    streamEndLumi = 3,
+    streamEndRun = 4,
+    globalBeginRun = 5,
+    globalBeginLumi = 6,
+    globalEndLumi = 7,
+    globalEndRun = 8,
+    sourceRun = 9,
+    sourceLumi = 10,
+    writeRun = 11,
+    writeLumi = 12
+  };
+
+  // stream number of the records not tied to a stream
+  constexpr std::uint32_t noStream = 0xffffffff;
+
+  struct Record {
+    std::uint64_t time;      // ns since the construction of the service
+    std::uint32_t id;        // module id, EventSetup component id, 0 otherwise
+    std::uint32_t stream;    // stream index, or noStream
+    std::uint8_t activity;   // Activity
+    char phase;              // 'B'egin or 'E'nd
+    std::uint16_t transition;// Transition
+    std::uint32_t unused;
+  };
+  static_assert(sizeof(Record) == 24, "the size of a Record is part of the file format");
+
+  template <typename T>
+  void append(std::string& oBuffer, T const& iValue) {
+    oBuffer.append(reinterpret_cast<char const*>(&iValue), sizeof(T));
+  }
+
+  Transition toTransition(edm::StreamContext const& iContext) {
+    using edm::StreamContext;
+    switch (iContext.transition()) {
+      case StreamContext::Transition::kBeginRun:
+        return Transition::streamBeginRun;
+      case StreamContext::Transition::kBeginLuminosityBlock:
+        return Transition::streamBeginLumi;
+      case StreamContext::Transition::kEndLuminosityBlock:
+        return Transition::streamEndLumi;
+      case StreamContext::Transition::kEndRun:
+        return Transition::streamEndRun;
+      default:
+        break;
+    }
+    return Transition::event;
+  }
+
+  Transition toTransition(edm::GlobalContext const& iContext) {
+    using edm::GlobalContext;
+    switch (iContext.transition()) {
+      case GlobalContext::Transition::kBeginRun:
+        return Transition::globalBeginRun;
+      case GlobalContext::Transition::kBeginLuminosityBlock:
+        return Transition::globalBeginLumi;
+      case GlobalContext::Transition::kEndLuminosityBlock:
+        return Transition::globalEndLumi;
+      case GlobalContext::Transition::kEndRun:
+        return Transition::globalEndRun;
+      case GlobalContext::Transition::kWriteRun:
+        return Transition::writeRun;
+      case GlobalContext::Transition::kWriteLuminosityBlock:
+        return Transition::writeLumi;
+      default:
+        break;
+    }
+    return Transition::globalBeginRun;
+  }
+
+}  // namespace
+
+namespace edm {
+  namespace service {
+
+    class TimelineTrace {
+    public:
+      TimelineTrace(ParameterSet const&, ActivityRegistry&);
+      ~TimelineTrace();
+      static void fillDescriptions(edm::ConfigurationDescriptions& descriptions);
+
+    private:
+      struct ThreadBuffer {
+        std::uint32_t index;
+        std::vector<Record> records;
+      };
+
+      void record(Activity iActivity, char iPhase, Transition iTransition, std::uint32_t iStream, std::uint32_t iId) {
+        auto& thread = buffers_.local();
+        thread.records.push_back(
+            Record{static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(clock_type::now() - begin_).count()),
+                   iId,
+                   iStream,
+                   static_cast<std::uint8_t>(iActivity),
+                   iPhase,
+                   static_cast<std::uint16_t>(iTransition),
+                   0});
+        if (thread.records.size() >= bufferSize_) {
+          flush(thread);
+        }
+      }
+
+      template <char P>
+      void module(StreamContext const& iSC, ModuleCallingContext const& iMCC) {
+        record(Activity::module, P, toTransition(iSC), iSC.streamID().value(), iMCC.moduleDescription()->id());
+      }
+      template <char P>
+      void moduleAcquire(StreamContext const& iSC, ModuleCallingContext const& iMCC) {
+        record(Activity::moduleAcquire, P, Transition::event, iSC.streamID().value(), iMCC.moduleDescription()->id());
+      }
+      template <char P>
+      void globalModule(GlobalContext const& iGC, ModuleCallingContext const& iMCC) {
+        record(Activity::module, P, toTransition(iGC), noStream, iMCC.moduleDescription()->id());
+      }
+      template <char P>
+      void stream(StreamContext const& iSC) {
+        record(Activity::transition, P, toTransition(iSC), iSC.streamID().value(), 0);
+      }
+      template <char P>
+      void global(GlobalContext const& iGC) {
+        record(Activity::transition, P, toTransition(iGC), noStream, 0);
+      }
+      template <char P>
+      void sourceEvent(StreamID iStream) {
+        record(Activity::source, P, Transition::event, iStream.value(), 0);
+      }
+      template <char P, Transition T, typename INDEX>
+      void sourceIndex(INDEX) {
+        record(Activity::source, P, T, noStream, 0);
+      }
+      template <char P>
+      void esProduce(eventsetup::ComponentDescription const* iDesc,
+                     eventsetup::EventSetupRecordKey const&,
+                     eventsetup::DataKey const&) {
+        record(Activity::esProduce, P, Transition::event, noStream, componentId(iDesc));
+      }
+      template <char P>
+      void esLock(eventsetup::ComponentDescription const* iDesc,
+                  eventsetup::EventSetupRecordKey const&,
+                  eventsetup::DataKey const&) {
+        record(Activity::esLock, P, Transition::event, noStream, componentId(iDesc));
+      }
+
+      void preModuleConstruction(ModuleDescription const&);
+      void postEndJob();
+
+      std::uint32_t componentId(eventsetup::ComponentDescription const*);
+      void writeName(Activity iActivity, std::uint32_t iId, std::string const& iName);
+      void flush(ThreadBuffer&);
+
+      ThreadSafeOutputFileStream file_;
+      std::size_t const bufferSize_;
+      clock_type::time_point const begin_;
+
+      std::atomic<std::uint32_t> nThreads_{0};
+      tbb::enumerable_thread_specific<ThreadBuffer> buffers_;
+
+      std::mutex componentsMutex_;
+      std::map<eventsetup::ComponentDescription const*, std::uint32_t> components_;
+    };
+
+  }  // namespace service
+}  // namespace edm
+
+using edm::service::TimelineTrace;
+
+TimelineTrace::TimelineTrace(ParameterSet const& iPS, ActivityRegistry& iRegistry)
+    : file_{iPS.getUntrackedParameter<std::string>("fileName")},
+      bufferSize_{iPS.getUntrackedParameter<unsigned int>("bufferSize")},
+      begin_{clock_type::now()},
+      buffers_{[this]() {
+        ThreadBuffer buffer{nThreads_++, {}};
+        buffer.records.reserve(bufferSize_);
+        return buffer;
+      }} {
+  if (not file_) {
+    throw edm::Exception(edm::errors::Configuration)
+        << "TimelineTrace: cannot open the file " << iPS.getUntrackedParameter<std::string>("fileName");
+  }
+  file_.write(std::string(magic, sizeof(magic)));
+
+  iRegistry.watchPreModuleConstruction(this, &TimelineTrace::preModuleConstruction);
+  iRegistry.watchPostEndJob(this, &TimelineTrace::postEndJob);
+
+  iRegistry.watchPreSourceEvent(this, &TimelineTrace::sourceEvent<'B'>);
+  iRegistry.watchPostSourceEvent(this, &TimelineTrace::sourceEvent<'E'>);
+  iRegistry.watchPreSourceLumi(this, &TimelineTrace::sourceIndex<'B', Transition::sourceLumi, LuminosityBlockIndex>);
+  iRegistry.watchPostSourceLumi(this, &TimelineTrace::sourceIndex<'E', Transition::sourceLumi, LuminosityBlockIndex>);
+  iRegistry.watchPreSourceRun(this, &TimelineTrace::sourceIndex<'B', Transition::sourceRun, RunIndex>);
+  iRegistry.watchPostSourceRun(this, &TimelineTrace::sourceIndex<'E', Transition::sourceRun, RunIndex>);
+
+  iRegistry.watchPreEvent(this, &TimelineTrace::stream<'B'>);
+  iRegistry.watchPostEvent(this, &TimelineTrace::stream<'E'>);
+  iRegistry.watchPreStreamBeginRun(this, &TimelineTrace::stream<'B'>);
+  iRegistry.watchPostStreamBeginRun(this, &TimelineTrace::stream<'E'>);
+  iRegistry.watchPreStreamBeginLumi(this, &TimelineTrace::stream<'B'>);
+  iRegistry.watchPostStreamBeginLumi(this, &TimelineTrace::stream<'E'>);
+  iRegistry.watchPreStreamEndLumi(this, &TimelineTrace::stream<'B'>);
+  iRegistry.watchPostStreamEndLumi(this, &TimelineTrace::stream<'E'>);
+  iRegistry.watchPreStreamEndRun(this, &TimelineTrace::stream<'B'>);
+  iRegistry.watchPostStreamEndRun(this, &TimelineTrace::stream<'E'>);
+
+  iRegistry.watchPreGlobalBeginRun(this, &TimelineTrace::global<'B'>);
+  iRegistry.watchPostGlobalBeginRun(this, &TimelineTrace::global<'E'>);
+  iRegistry.watchPreGlobalBeginLumi(this, &TimelineTrace::global<'B'>);
+  iRegistry.watchPostGlobalBeginLumi(this, &TimelineTrace::global<'E'>);
+  iRegistry.watchPreGlobalEndLumi(this, &TimelineTrace::global<'B'>);
+  iRegistry.watchPostGlobalEndLumi(this, &TimelineTrace::global<'E'>);
+  iRegistry.watchPreGlobalEndRun(this, &TimelineTrace::global<'B'>);
+  iRegistry.watchPostGlobalEndRun(this, &TimelineTrace::global<'E'>);
+
+  iRegistry.watchPreModuleEvent(this, &TimelineTrace::module<'B'>);
+  iRegistry.watchPostModuleEvent(this, &TimelineTrace::module<'E'>);
+  iRegistry.watchPreModuleEventAcquire(this, &TimelineTrace::moduleAcquire<'B'>);
+  iRegistry.watchPostModuleEventAcquire(this, &TimelineTrace::moduleAcquire<'E'>);
+  iRegistry.watchPreModuleStreamBeginRun(this, &TimelineTrace::module<'B'>);
+  iRegistry.watchPostModuleStreamBeginRun(this, &TimelineTrace::module<'E'>);
+  iRegistry.watchPreModuleStreamBeginLumi(this, &TimelineTrace::module<'B'>);
+  iRegistry.watchPostModuleStreamBeginLumi(this, &TimelineTrace::module<'E'>);
+  iRegistry.watchPreModuleStreamEndLumi(this, &TimelineTrace::module<'B'>);
+  iRegistry.watchPostModuleStreamEndLumi(this, &TimelineTrace::module<'E'>);
+  iRegistry.watchPreModuleStreamEndRun(this, &TimelineTrace::module<'B'>);
+  iRegistry.watchPostModuleStreamEndRun(this, &TimelineTrace::module<'E'>);
+
+  iRegistry.watchPreModuleGlobalBeginRun(this, &TimelineTrace::globalModule<'B'>);
+  iRegistry.watchPostModuleGlobalBeginRun(this, &TimelineTrace::globalModule<'E'>);
+  iRegistry.watchPreModuleGlobalBeginLumi(this, &TimelineTrace::globalModule<'B'>);
+  iRegistry.watchPostModuleGlobalBeginLumi(this, &TimelineTrace::globalModule<'E'>);
+  iRegistry.watchPreModuleGlobalEndLumi(this, &TimelineTrace::globalModule<'B'>);
+  iRegistry.watchPostModuleGlobalEndLumi(this, &TimelineTrace::globalModule<'E'>);
+  iRegistry.watchPreModuleGlobalEndRun(this, &TimelineTrace::globalModule<'B'>);
+  iRegistry.watchPostModuleGlobalEndRun(this, &TimelineTrace::globalModule<'E'>);
+  iRegistry.watchPreModuleWriteRun(this, &TimelineTrace::globalModule<'B'>);
+  iRegistry.watchPostModuleWriteRun(this, &TimelineTrace::globalModule<'E'>);
+  iRegistry.watchPreModuleWriteLumi(this, &TimelineTrace::globalModule<'B'>);
+  iRegistry.watchPostModuleWriteLumi(this, &TimelineTrace::globalModule<'E'>);
+
+  // waiting for the lock of the EventSetup, then producing the data
+  iRegistry.watchPreLockEventSetupGet(this, &TimelineTrace::esLock<'B'>);
+  iRegistry.watchPostLockEventSetupGet(this, &TimelineTrace::esLock<'E'>);
+  iRegistry.watchPostLockEventSetupGet(this, &TimelineTrace::esProduce<'B'>);
+  iRegistry.watchPostEventSetupGet(this, &TimelineTrace::esProduce<'E'>);
+
+  writeName(Activity::source, 0, "source");
+}
+
+TimelineTrace::~TimelineTrace() {
+  for (auto& buffer : buffers_) {
+    flush(buffer);
+  }
+}
+
+void TimelineTrace::fillDescriptions(ConfigurationDescriptions& descriptions) {
+  ParameterSetDescription desc;
+  desc.addUntracked<std::string>("fileName", "timeline.trace")
+      ->setComment(
+          "Name of the binary file the activities are written to. Convert it with\n"
+          "edmTimelineTraceToJSON.py for chrome://tracing or https://ui.perfetto.dev");
+  desc.addUntracked<unsigned int>("bufferSize", 4096)
+      ->setComment("Number of records (24 bytes each) a thread keeps before writing them to the file.");
+  descriptions.add("TimelineTrace", desc);
+  descriptions.setComment(
+      "This service records the begin and end times of the source, modules, EventSetup producers and transitions "
+      "on every thread, for display as a timeline.");
+}
+
+void TimelineTrace::preModuleConstruction(ModuleDescription const& iDesc) {
+  writeName(Activity::module, iDesc.id(), iDesc.moduleLabel());
+}
+
+std::uint32_t TimelineTrace::componentId(eventsetup::ComponentDescription const* iDesc) {
+  std::lock_guard<std::mutex> guard(componentsMutex_);
+  auto found = components_.find(iDesc);
+  if (found != components_.end()) {
+    return found->second;
+  }
+  std::uint32_t const id = components_.size();
+  components_.emplace(iDesc, id);
+  writeName(Activity::esProduce, id, iDesc == nullptr ? std::string("unknown") : iDesc->type_ + ":" + iDesc->label_);
+  return id;
+}
+
+void TimelineTrace::writeName(Activity iActivity, std::uint32_t iId, std::string const& iName) {
+  std::string block;
+  append(block, Block::name);
+  append(block, static_cast<std::uint32_t>(2 * sizeof(std::uint32_t) + iName.size()));
+  append(block, static_cast<std::uint32_t>(iActivity));
+  append(block, iId);
+  block += iName;
+  file_.write(std::move(block));
+}
+
+void TimelineTrace::flush(ThreadBuffer& iBuffer) {
+  if (iBuffer.records.empty()) {
+    return;
+  }
+  std::string block;
+  auto const size = iBuffer.records.size() * sizeof(Record);
+  block.reserve(3 * sizeof(std::uint32_t) + size);
+  append(block, Block::records);
+  append(block, static_cast<std::uint32_t>(sizeof(std::uint32_t) + size));
+  append(block, iBuffer.index);
+  block.append(reinterpret_cast<char const*>(iBuffer.records.data()), size);
+  file_.write(std::move(block));
+  iBuffer.records.clear();
+}
+
+void TimelineTrace::postEndJob() {
+  for (auto& buffer : buffers_) {
+    flush(buffer);
+  }
+}
+
+DEFINE_FWK_SERVICE(TimelineTrace);
@@ -31,8 +31,10 @@
 #include <sstream>
 #include <sys/resource.h>
 #include <sys/time.h>
+#include <algorithm>
 #include <atomic>
 #include <exception>
+#include <map>
 
 namespace edm {
 
@@ -80,6 +82,12 @@ namespace edm {
       void preModule(ModuleDescription const& md);
       void postModule(ModuleDescription const& md);
 
+      void preModuleConstruction(ModuleDescription const& md);
+      void postModuleConstruction(ModuleDescription const& md);
+      void preModuleBeginJob(ModuleDescription const& md);
+      void postModuleBeginJob(ModuleDescription const& md);
+      void reportStartup() const;
+
       void preModuleGlobal(GlobalContext const&, ModuleCallingContext const&);
       void postModuleGlobal(GlobalContext const&, ModuleCallingContext const&);
 
@@ -148,6 +156,18 @@ namespace edm {
 
       bool configuredInTopLevelProcess_;
       unsigned int nSubProcesses_;
+
+      // time spent by each module in its constructor and beginJob, keyed by module id.
+      // Both transitions are run serially, before any event processing.
+      struct StartupTime {
+        std::string label_;
+        std::string type_;
+        double start_ = 0.;
+        double construction_ = 0.;
+        double beginJob_ = 0.;
+      };
+      unsigned int startupReportSize_;
+      std::map<unsigned int, StartupTime> startupTimes_;
     };
   }
 }
@@ -242,7 +262,8 @@ namespace edm {
         countAndTimeForGet_{&countAndTimeZero_},
         accumulatedTimeForGet_{0.0},
         configuredInTopLevelProcess_{false},
-        nSubProcesses_{0} {
+        nSubProcesses_{0},
+        startupReportSize_(iPS.getUntrackedParameter<unsigned int>("startupReportSize")) {
 
       iRegistry.watchPreBeginJob(this, &Timing::preBeginJob);
       iRegistry.watchPostBeginJob(this, &Timing::postBeginJob);
@@ -315,6 +336,13 @@ namespace edm {
         iRegistry.watchPostSourceConstruction(this, &Timing::postModule);
       }
 
+      if(startupReportSize_ > 0) {
+        iRegistry.watchPreModuleConstruction(this, &Timing::preModuleConstruction);
+        iRegistry.watchPostModuleConstruction(this, &Timing::postModuleConstruction);
+        iRegistry.watchPreModuleBeginJob(this, &Timing::preModuleBeginJob);
+        iRegistry.watchPostModuleBeginJob(this, &Timing::postModuleBeginJob);
+      }
+
       iRegistry.watchPostGlobalBeginRun(this, &Timing::postGlobalBeginRun);
       iRegistry.watchPostGlobalBeginLumi(this, &Timing::postGlobalBeginLumi);
 
@@ -358,6 +386,9 @@ namespace edm {
        "If 'true' write summary information to JobReport");
       desc.addUntracked<double>("excessiveTimeThreshold", 0.)->setComment(
        "Amount of time in seconds before reporting a module or source has taken excessive time. A value of 0.0 turns off this reporting.");
+      desc.addUntracked<unsigned int>("startupReportSize", 0)->setComment(
+       "Number of modules with the longest construction plus beginJob time to list, together with the total time spent in "
+       "module construction and beginJob, once beginJob is done. A value of 0 turns off this reporting.");
       descriptions.add("Timing", desc);
       descriptions.setComment(
        "This service reports the time it takes to run each module in a job.");
@@ -387,6 +418,37 @@ namespace edm {
         << "eventnum runnum modulelabel modulename timetakeni\n"
         << "TimeReport> JobTime=" << curr_job_time_  << " JobCPU=" << curr_job_cpu_  << "\n";
       }
+      if(startupReportSize_ > 0) {
+        reportStartup();
+      }
+    }
+
+    void Timing::reportStartup() const {
+      std::vector<StartupTime const*> modules;
+      modules.reserve(startupTimes_.size());
+      double total_construction = 0.;
+      double total_beginJob = 0.;
+      for(auto const& entry : startupTimes_) {
+        modules.push_back(&entry.second);
+        total_construction += entry.second.construction_;
+        total_beginJob += entry.second.beginJob_;
+      }
+      auto const nReported = std::min<std::size_t>(startupReportSize_, modules.size());
+      std::partial_sort(modules.begin(), modules.begin() + nReported, modules.end(),
+                        [](StartupTime const* a, StartupTime const* b) {
+                          return a->construction_ + a->beginJob_ > b->construction_ + b->beginJob_;
+                        });
+
+      LogImportant log("TimeReport");
+      log << "TimeReport> Startup Summary: \n"
+          << " - Modules:              " << modules.size() << "\n"
+          << " - Total construction:   " << total_construction << "\n"
+          << " - Total beginJob:       " << total_beginJob << "\n"
+          << " Slowest modules (construction beginJob label type): \n";
+      for(std::size_t i = 0; i < nReported; ++i) {
+        log << " - " << modules[i]->construction_ << " " << modules[i]->beginJob_ << " "
+            << modules[i]->label_ << " " << modules[i]->type_ << "\n";
+      }
     }
 
     void Timing::postEndJob() {
@@ -599,6 +661,31 @@ namespace edm {
       postCommon();
     }
 
+    void
+    Timing::preModuleConstruction(ModuleDescription const& desc) {
+      auto& entry = startupTimes_[desc.id()];
+      entry.label_ = desc.moduleLabel();
+      entry.type_ = desc.moduleName();
+      entry.start_ = getTime();
+    }
+
+    void
+    Timing::postModuleConstruction(ModuleDescription const& desc) {
+      auto& entry = startupTimes_[desc.id()];
+      entry.construction_ += getTime() - entry.start_;
+    }
+
+    void
+    Timing::preModuleBeginJob(ModuleDescription const& desc) {
+      startupTimes_[desc.id()].start_ = getTime();
+    }
+
+    void
+    Timing::postModuleBeginJob(ModuleDescription const& desc) {
+      auto& entry = startupTimes_[desc.id()];
+      entry.beginJob_ += getTime() - entry.start_;
+    }
+
     void
     Timing::preModuleGlobal(GlobalContext const&, ModuleCallingContext const&) {
       pushStack(configuredInTopLevelProcess_);
@@ -0,0 +1,169 @@
+#!/usr/bin/env python
+from __future__ import print_function
+import argparse
+import json
+import struct
+import sys
+
+#----------------------------------------------
+# Converts the binary file written by the TimelineTrace service into the
+# Chrome trace event JSON format, which can be opened with chrome://tracing
+# or https://ui.perfetto.dev
+#
+# File layout (little endian), see FWCore/Services/plugins/TimelineTrace.cc:
+#   8 bytes magic 'EDMTLV01'
+#   then blocks of: uint32 kind, uint32 size, <size> bytes
+#     kind 1, records: uint32 thread index, then 24 byte records
+#        uint64 time (ns), uint32 id, uint32 stream, uint8 activity,
+#        char phase ('B' or 'E'), uint16 transition, uint32 unused
+#     kind 2, name: uint32 activity, uint32 id, then the name
+#----------------------------------------------
+
+kMagic = b'EDMTLV01'
+kRecords = 1
+kName = 2
+kRecordFormat = '<QIIBcHI'
+kRecordSize = struct.calcsize(kRecordFormat)
+kNoStream = 0xffffffff
+
+# activities
+kSource = 0
+kModule = 1
+kModuleAcquire = 2
+kTransition = 3
+kESProduce = 4
+kESLock = 5
+
+kActivityNames = {kSource: 'source', kModule: 'module', kModuleAcquire: 'acquire',
+                  kTransition: 'transition', kESProduce: 'EventSetup', kESLock: 'EventSetup lock'}
+
+kTransitionNames = ['event', 'stream begin run', 'stream begin lumi', 'stream end lumi', 'stream end run',
+                    'global begin run', 'global begin lumi', 'global end lumi', 'global end run',
+                    'run', 'lumi', 'write run', 'write lumi']
+
+# the activities of the threads, and the transitions of the streams, are shown as two processes
+kThreadsPid = 1
+kStreamsPid = 2
+# tid of the global transitions among the streams
+kGlobalTid = -1
+
+
+def readBlocks(f):
+    if f.read(len(kMagic)) != kMagic:
+        raise RuntimeError('not a TimelineTrace file')
+    while True:
+        header = f.read(8)
+        if len(header) < 8:
+            return
+        kind, size = struct.unpack('<II', header)
+        payload = f.read(size)
+        if len(payload) < size:
+            print('warning: the file is truncated', file=sys.stderr)
+            return
+        yield kind, payload
+
+
+def transitionName(transition):
+    if transition < len(kTransitionNames):
+        return kTransitionNames[transition]
+    return 'transition %d' % transition
+
+
+class Converter(object):
+    def __init__(self):
+        self.names = {}
+        self.records = []
+        self.threads = set()
+        self.streams = set()
+
+    def read(self, f):
+        for kind, payload in readBlocks(f):
+            if kind == kName:
+                activity, id = struct.unpack_from('<II', payload)
+                self.names[(activity, id)] = payload[8:].decode('utf-8', 'replace')
+            elif kind == kRecords:
+                thread, = struct.unpack_from('<I', payload)
+                self.threads.add(thread)
+                for offset in range(4, len(payload) - kRecordSize + 1, kRecordSize):
+                    time, id, stream, activity, phase, transition, _ = struct.unpack_from(kRecordFormat, payload, offset)
+                    self.records.append((time, thread, id, stream, activity, phase, transition))
+        # blocks of different threads are interleaved
+        self.records.sort(key=lambda r: r[0])
+
+    def name(self, activity, id, transition):
+        if activity == kSource:
+            return 'source ' + transitionName(transition)
+        if activity == kTransition:
+            return transitionName(transition)
+        if activity in (kESProduce, kESLock):
+            name = self.names.get((kESProduce, id), 'EventSetup %d' % id)
+            return name if activity == kESProduce else 'lock ' + name
+        name = self.names.get((kModule, id), 'module %d' % id)
+        if activity == kModuleAcquire:
+            return name + ' acquire'
+        if transition != 0:
+            return name + ' ' + transitionName(transition)
+        return name
+
+    def events(self):
+        # begin and end are paired into complete ('X') events: per thread the
+        # activities are nested, the transitions are paired per stream
+        running = {}
+        for time, thread, id, stream, activity, phase, transition in self.records:
+            if activity == kTransition:
+                key = (kStreamsPid, stream, transition)
+            else:
+                key = (kThreadsPid, thread)
+            if phase == b'B':
+                running.setdefault(key, []).append((time, id, stream, activity, transition))
+                continue
+            begins = running.get(key)
+            if not begins:
+                continue
+            begin, id, stream, activity, transition = begins.pop()
+            if activity == kTransition:
+                pid = kStreamsPid
+                tid = kGlobalTid if stream == kNoStream else stream
+                self.streams.add(tid)
+            else:
+                pid = kThreadsPid
+                tid = thread
+            event = {'name': self.name(activity, id, transition), 'cat': kActivityNames.get(activity, 'unknown'),
+                     'ph': 'X', 'pid': pid, 'tid': tid, 'ts': begin / 1000., 'dur': (time - begin) / 1000.}
+            if stream != kNoStream and activity != kTransition:
+                event['args'] = {'stream': stream}
+            yield event
+        yield {'name': 'process_name', 'ph': 'M', 'pid': kThreadsPid, 'args': {'name': 'threads'}}
+        yield {'name': 'process_name', 'ph': 'M', 'pid': kStreamsPid, 'args': {'name': 'streams'}}
+        for thread in sorted(self.threads):
+            yield {'name': 'thread_name', 'ph': 'M', 'pid': kThreadsPid, 'tid': thread, 'args': {'name': 'thread %d' % thread}}
+        for stream in sorted(self.streams):
+            name = 'global' if stream == kGlobalTid else 'stream %d' % stream
+            yield {'name': 'thread_name', 'ph': 'M', 'pid': kStreamsPid, 'tid': stream, 'args': {'name': name}}
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Convert the output of the TimelineTrace service to the Chrome trace / Perfetto JSON format.')
+    parser.add_argument('input', help='file written by the TimelineTrace service')
+    parser.add_argument('output', nargs='?', default='-', help='JSON file to write, the standard output by default')
+    args = parser.parse_args()
+
+    converter = Converter()
+    with open(args.input, 'rb') as f:
+        converter.read(f)
+
+    out = sys.stdout if args.output == '-' else open(args.output, 'w')
+    out.write('{"traceEvents": [\n')
+    first = True
+    for event in converter.events():
+        if not first:
+            out.write(',\n')
+        first = False
+        out.write(json.dumps(event))
+    out.write('\n], "displayTimeUnit": "ms"}\n')
+    if out is not sys.stdout:
+        out.close()
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,23 @@
+#!/bin/bash
+
+# Pass in name and status
+function die { echo $1: status $2 ;  exit $2; }
+
+F1=${LOCAL_TEST_DIR}/test_hardwarecounters_cfg.py
+
+rm -f test_hardwarecounters.folded
+(cmsRun $F1 > test_hardwarecounters.log 2>&1 ) || { cat test_hardwarecounters.log; die "Failure using $F1" $?; }
+
+# the summary is printed even when the counters cannot be read
+grep -q "HardwareCounters> Module label" test_hardwarecounters.log || die "No module summary in test_hardwarecounters.log" 1
+grep -q "HardwareCounters> Path" test_hardwarecounters.log || die "No path summary in test_hardwarecounters.log" 1
+
+# without access to the PMU (e.g. in a container) only the warning is expected
+if grep -q -e "The hardware counters cannot be read" -e "The hardware counters were never scheduled" test_hardwarecounters.log; then
+  echo "The hardware counters are not available, only the warning was checked"
+  exit 0
+fi
+
+for module in one two; do
+  grep -q "^cmsRun;p;${module} [0-9]*$" test_hardwarecounters.folded || die "No '${module}' line in test_hardwarecounters.folded" 1
+done
@@ -0,0 +1,27 @@
+#!/bin/bash
+
+# Pass in name and status
+function die { echo $1: status $2 ;  exit $2; }
+
+F1=${LOCAL_TEST_DIR}/test_moduleallocationmonitor_cfg.py
+
+WARNING="The allocation hooks of jemalloc (version 5.1 or later) are not available"
+SUMMARY="ModuleAllocationMonitor> Module label"
+
+# with jemalloc: the summary, or the warning if jemalloc is too old to have the hooks
+(cmsRunJE $F1 > test_moduleallocationmonitor_je.log 2>&1 ) || { cat test_moduleallocationmonitor_je.log; die "Failure using cmsRunJE $F1" $?; }
+if grep -q -F "$SUMMARY" test_moduleallocationmonitor_je.log; then
+  for module in one two; do
+    grep -q "^ModuleAllocationMonitor> *${module} " test_moduleallocationmonitor_je.log || die "No '${module}' line in test_moduleallocationmonitor_je.log" 1
+  done
+else
+  grep -q -F "$WARNING" test_moduleallocationmonitor_je.log || die "Neither summary nor warning in test_moduleallocationmonitor_je.log" 1
+  echo "The jemalloc hooks are not available, only the warning was checked"
+fi
+
+# with the glibc allocator there are no hooks: the warning, and no summary
+(cmsRunGlibC $F1 > test_moduleallocationmonitor_glibc.log 2>&1 ) || { cat test_moduleallocationmonitor_glibc.log; die "Failure using cmsRunGlibC $F1" $?; }
+grep -q -F "$WARNING" test_moduleallocationmonitor_glibc.log || die "No warning in test_moduleallocationmonitor_glibc.log" 1
+grep -q -F "$SUMMARY" test_moduleallocationmonitor_glibc.log && die "Unexpected summary in test_moduleallocationmonitor_glibc.log" 1
+
+exit 0
@@ -0,0 +1,21 @@
+import FWCore.ParameterSet.Config as cms
+
+process = cms.Process("TEST")
+
+process.source = cms.Source("EmptySource")
+
+process.maxEvents = cms.untracked.PSet(input = cms.untracked.int32(20))
+
+process.options = cms.untracked.PSet(
+    numberOfThreads = cms.untracked.uint32(2),
+    numberOfStreams = cms.untracked.uint32(2)
+)
+
+# sample often, so that the call sites of the small allocations are reported too
+process.add_(cms.Service("ModuleAllocationMonitor",
+                         sampleBytes = cms.untracked.uint64(1024)))
+
+process.one = cms.EDProducer("IntProducer", ivalue = cms.int32(1))
+process.two = cms.EDProducer("IntProducer", ivalue = cms.int32(2))
+
+process.p = cms.Path(process.one + process.two)
@@ -0,0 +1,25 @@
+#!/bin/bash
+
+# Pass in name and status
+function die { echo $1: status $2 ;  exit $2; }
+
+F1=${LOCAL_TEST_DIR}/test_timelinetrace_cfg.py
+
+(cmsRun $F1 ) || die "Failure using $F1" $?
+(edmTimelineTraceToJSON.py test_timelinetrace.trace test_timelinetrace.json ) || die "Failure converting test_timelinetrace.trace" $?
+
+# every event, and every module in every event, is a complete event of the timeline
+python - <<'PYTHON' || die "Wrong content of test_timelinetrace.json" $?
+from __future__ import print_function
+import json
+import sys
+events = json.load(open("test_timelinetrace.json"))["traceEvents"]
+counts = {}
+for e in events:
+    if e["ph"] == "X":
+        counts[e["name"]] = counts.get(e["name"], 0) + 1
+for name in ("event", "one", "two"):
+    if counts.get(name) != 20:
+        print(counts.get(name, 0), "'" + name + "' activities instead of 20")
+        sys.exit(1)
+PYTHON
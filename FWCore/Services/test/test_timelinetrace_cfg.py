@@ -0,0 +1,22 @@
+import FWCore.ParameterSet.Config as cms
+
+process = cms.Process("TEST")
+
+process.source = cms.Source("EmptySource")
+
+process.maxEvents = cms.untracked.PSet(input = cms.untracked.int32(20))
+
+process.options = cms.untracked.PSet(
+    numberOfThreads = cms.untracked.uint32(2),
+    numberOfStreams = cms.untracked.uint32(2)
+)
+
+# a small buffer, so that each thread writes several blocks
+process.add_(cms.Service("TimelineTrace",
+                         fileName = cms.untracked.string("test_timelinetrace.trace"),
+                         bufferSize = cms.untracked.uint32(16)))
+
+process.one = cms.EDProducer("IntProducer", ivalue = cms.int32(1))
+process.two = cms.EDProducer("IntProducer", ivalue = cms.int32(2))
+
+process.p = cms.Path(process.one + process.two)
@@ -0,0 +1,45 @@
+#ifndef IOPool_Common_BranchCompression_h
+#define IOPool_Common_BranchCompression_h
+
+/*----------------------------------------------------------------------
+
+Compression settings shared by the ROOT output modules: the ROOT code of
+the compression algorithm names, and the per branch compression given with
+the 'overrideBranchesCompression' parameter.
+
+----------------------------------------------------------------------*/
+
+#include <regex>
+#include <string>
+#include <vector>
+
+namespace edm {
+  class ParameterSet;
+  class ParameterSetDescription;
+
+  // ROOT compression algorithm code for "ZLIB", "LZMA", "LZ4" or "ZSTD" (if supported by ROOT).
+  // Throws a Configuration exception naming iModule for any other algorithm.
+  int compressionAlgorithmCode(std::string const& iAlgorithm, std::string const& iModule);
+
+  struct SpecialCompressionForBranch {
+    SpecialCompressionForBranch(std::string const& iBranchName, std::string const& iAlgorithm, int iLevel,
+                                std::string const& iModule);
+    bool match(std::string const& iBranchName) const;
+
+    std::regex branch_;
+    // same encoding as ROOT::CompressionSettings()
+    int compression_;
+  };
+
+  typedef std::vector<SpecialCompressionForBranch> SpecialCompressionForBranches;
+
+  // reads the 'overrideBranchesCompression' parameter of an output module
+  SpecialCompressionForBranches specialCompressionForBranches(ParameterSet const& iPSet, std::string const& iModule);
+
+  // the compression settings of the last entry matching iBranchName, -1 if there is none
+  int specialCompression(SpecialCompressionForBranches const& iSpecial, std::string const& iBranchName);
+
+  void fillSpecialCompressionDescription(ParameterSetDescription& iDesc);
+}
+
+#endif
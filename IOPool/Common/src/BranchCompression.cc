@@ -0,0 +1,75 @@
+#include "IOPool/Common/interface/BranchCompression.h"
+
+#include "FWCore/ParameterSet/interface/ParameterSet.h"
+#include "FWCore/ParameterSet/interface/ParameterSetDescription.h"
+#include "FWCore/Utilities/interface/EDMException.h"
+#include "FWCore/Utilities/interface/RegexMatch.h"
+
+#include "Compression.h"
+#include "RVersion.h"
+
+namespace edm {
+
+  int compressionAlgorithmCode(std::string const& iAlgorithm, std::string const& iModule) {
+    if (iAlgorithm == std::string("ZLIB")) {
+      return ROOT::kZLIB;
+    } else if (iAlgorithm == std::string("LZMA")) {
+      return ROOT::kLZMA;
+    } else if (iAlgorithm == std::string("LZ4")) {
+      return ROOT::kLZ4;
+#if ROOT_VERSION_CODE >= ROOT_VERSION(6,20,0)
+    } else if (iAlgorithm == std::string("ZSTD")) {
+      return ROOT::kZSTD;
+#endif
+    }
+    throw Exception(errors::Configuration) << iModule << " configured with unknown compression algorithm '" << iAlgorithm << "'\n"
+#if ROOT_VERSION_CODE >= ROOT_VERSION(6,20,0)
+                                           << "Allowed compression algorithms are ZLIB, LZMA, LZ4 and ZSTD\n";
+#else
+                                           << "Allowed compression algorithms are ZLIB, LZMA and LZ4\n";
+#endif
+  }
+
+  SpecialCompressionForBranch::SpecialCompressionForBranch(std::string const& iBranchName,
+                                                           std::string const& iAlgorithm,
+                                                           int iLevel,
+                                                           std::string const& iModule) :
+    branch_(glob2reg(iBranchName)),
+    compression_(100 * compressionAlgorithmCode(iAlgorithm, iModule) + iLevel) {
+  }
+
+  bool SpecialCompressionForBranch::match(std::string const& iBranchName) const {
+    return std::regex_match(iBranchName, branch_);
+  }
+
+  SpecialCompressionForBranches specialCompressionForBranches(ParameterSet const& iPSet, std::string const& iModule) {
+    auto const& specialCompression {iPSet.getUntrackedParameterSetVector("overrideBranchesCompression")};
+    SpecialCompressionForBranches result;
+    result.reserve(specialCompression.size());
+    for(auto const& s: specialCompression) {
+      result.emplace_back(s.getUntrackedParameter<std::string>("branch"),
+                          s.getUntrackedParameter<std::string>("compressionAlgorithm"),
+                          s.getUntrackedParameter<int>("compressionLevel"),
+                          iModule);
+    }
+    return result;
+  }
+
+  int specialCompression(SpecialCompressionForBranches const& iSpecial, std::string const& iBranchName) {
+    int compression = -1;
+    for(auto const& b: iSpecial) {
+      if(b.match(iBranchName)) {
+        compression = b.compression_;
+      }
+    }
+    return compression;
+  }
+
+  void fillSpecialCompressionDescription(ParameterSetDescription& iDesc) {
+    ParameterSetDescription specialCompression;
+    specialCompression.addUntracked<std::string>("branch")->setComment("Name of the branches needing a special compression. The name can contain wildcards '*' and '?'. The last matching entry is used");
+    specialCompression.addUntracked<std::string>("compressionAlgorithm")->setComment("The compression algorithm for the branches, same values as compressionAlgorithm");
+    specialCompression.addUntracked<int>("compressionLevel")->setComment("The compression level for the branches");
+    iDesc.addVPSetUntracked("overrideBranchesCompression", specialCompression, std::vector<ParameterSet>());
+  }
+}
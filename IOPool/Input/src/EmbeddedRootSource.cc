@@ -74,6 +74,9 @@ namespace edm {
     ParameterSet pset;
     pset.addUntrackedParameter("inputCommands", rules);
     productSelectorRules_ = ProductSelectorRules(pset, "inputCommands", "InputSource");
+    // The first file was opened with the original selection; reopen it so
+    // that the branches not used for mixing are dropped on input there too.
+    fileSequence_->reopenCurrentFile();
   }
 
   void
@@ -163,6 +163,30 @@ namespace edm {
     }
   }
 
+  // Reopens the file that is currently open so that a product selection
+  // changed after construction (dropUnwantedBranches) also applies to it.
+  // Intended to be called before any event has been read.
+  void
+  RootEmbeddedFileSequence::reopenCurrentFile() {
+    if(!rootFile()) {
+      return;
+    }
+    if(sequential_) {
+      // start over as in the constructor, the skipped events may span files
+      setAtFirstFile();
+    }
+    initFile(false);
+    assert(rootFile());
+    if(sequential_) {
+      rootFile()->setAtEventEntry(IndexIntoFile::invalidEntry);
+      if(!sameLumiBlock_) {
+        skipEntries(initialNumberOfEventsToSkip_);
+      }
+    } else {
+      eventsRemainingInFile_ = 0;
+    }
+  }
+
   bool
   RootEmbeddedFileSequence::readOneSequential(EventPrincipal& cache, size_t& fileNameHash, CLHEP::HepRandomEngine*, EventID const*, bool recycleFiles) {
     assert(rootFile());
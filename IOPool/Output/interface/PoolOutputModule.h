@@ -18,6 +18,7 @@
 #include <vector>
 #include <regex>
 
+#include "IOPool/Common/interface/BranchCompression.h"
 #include "IOPool/Common/interface/RootServiceChecker.h"
 #include "FWCore/Framework/interface/Frameworkfwd.h"
 #include "FWCore/Framework/interface/one/OutputModule.h"
@@ -86,7 +87,7 @@ namespace edm {
 
       OutputItem();
 
-      explicit OutputItem(BranchDescription const* bd, EDGetToken const& token, int splitLevel, int basketSize);
+      explicit OutputItem(BranchDescription const* bd, EDGetToken const& token, int splitLevel, int basketSize, int compression);
 
       ~OutputItem() {}
 
@@ -102,6 +103,7 @@ namespace edm {
       mutable void const* product_;
       int splitLevel_;
       int basketSize_;
+      int compression_; // ROOT compression settings, -1 for the file default
     };
 
     typedef std::vector<OutputItem> OutputItemList;
@@ -173,6 +175,7 @@ namespace edm {
     AuxItemArray auxItems_;
     OutputItemListArray selectedOutputItemList_;
     std::vector<SpecialSplitLevelForBranch> specialSplitLevelForBranches_;
+    SpecialCompressionForBranches specialCompressionForBranches_;
     std::string const fileName_;
     std::string const logicalFileName_;
     std::string const catalog_;
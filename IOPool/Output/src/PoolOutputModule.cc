@@ -94,6 +94,8 @@ namespace edm {
       specialSplitLevelForBranches_.emplace_back(s.getUntrackedParameter<std::string>("branch"),
                                                  s.getUntrackedParameter<int>("splitLevel"));
     }
+
+    specialCompressionForBranches_ = specialCompressionForBranches(pset, "PoolOutputModule");
       
     // We don't use this next parameter, but we read it anyway because it is part
     // of the configuration of this module.  An external parser creates the
@@ -123,14 +125,16 @@ namespace edm {
         token_(),
         product_(nullptr),
         splitLevel_(BranchDescription::invalidSplitLevel),
-        basketSize_(BranchDescription::invalidBasketSize) {}
+        basketSize_(BranchDescription::invalidBasketSize),
+        compression_(-1) {}
 
-  PoolOutputModule::OutputItem::OutputItem(BranchDescription const* bd, EDGetToken const& token, int splitLevel, int basketSize) :
+  PoolOutputModule::OutputItem::OutputItem(BranchDescription const* bd, EDGetToken const& token, int splitLevel, int basketSize, int compression) :
         branchDescription_(bd),
         token_(token),
         product_(nullptr),
         splitLevel_(splitLevel),
-        basketSize_(basketSize) {}
+        basketSize_(basketSize),
+        compression_(compression) {}
 
 
   PoolOutputModule::OutputItem::Sorter::Sorter(TTree* tree) : treeMap_(new std::map<std::string, int>) {
@@ -214,7 +218,9 @@ namespace edm {
         }
         basketSize = (prod.basketSize() == BranchDescription::invalidBasketSize ? basketSize_ : prod.basketSize());
       }
-      outputItemList.emplace_back(&prod, kept.second, splitLevel, basketSize);
+      // Note that fast cloned branches keep the compression of the input file.
+      int compression = specialCompression(specialCompressionForBranches_, prod.branchName());
+      outputItemList.emplace_back(&prod, kept.second, splitLevel, basketSize, compression);
     }
 
     // Sort outputItemList to allow fast copying.
@@ -446,7 +452,7 @@ namespace edm {
     desc.addUntracked<int>("compressionLevel", 9)
         ->setComment("ROOT compression level of output file.");
     desc.addUntracked<std::string>("compressionAlgorithm", "ZLIB")
-        ->setComment("Algorithm used to compress data in the ROOT output file, allowed values are ZLIB and LZMA");
+        ->setComment("Algorithm used to compress data in the ROOT output file, allowed values are ZLIB, LZMA, LZ4 and ZSTD (if supported by ROOT)");
     desc.addUntracked<int>("basketSize", 16384)
         ->setComment("Default ROOT basket size in output file.");
     desc.addUntracked<int>("eventAutoFlushCompressedSize",20*1024*1024)
@@ -484,6 +490,7 @@ namespace edm {
       specialSplit.addUntracked<int>("splitLevel")->setComment("The special split level for the branch");
       desc.addVPSetUntracked("overrideBranchesSplitLevel",specialSplit, std::vector<ParameterSet>());
     }
+    fillSpecialCompressionDescription(desc);
     OutputModule::fillDescription(desc);
   }
 
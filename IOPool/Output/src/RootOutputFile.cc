@@ -114,15 +114,9 @@ namespace edm {
       processHistoryRegistry_(),
       parentageIDs_(),
       branchesWithStoredHistory_(),
+      producedEventBranches_(),
       wrapperBaseTClass_(TClass::GetClass("edm::WrapperBase")) {
-    if (om_->compressionAlgorithm() == std::string("ZLIB")) {
-      filePtr_->SetCompressionAlgorithm(ROOT::kZLIB);
-    } else if (om_->compressionAlgorithm() == std::string("LZMA")) {
-      filePtr_->SetCompressionAlgorithm(ROOT::kLZMA);
-    } else {
-      throw Exception(errors::Configuration) << "PoolOutputModule configured with unknown compression algorithm '" << om_->compressionAlgorithm() << "'\n"
-					     << "Allowed compression algorithms are ZLIB and LZMA\n";
-    }
+    filePtr_->SetCompressionAlgorithm(compressionAlgorithmCode(om_->compressionAlgorithm(), "PoolOutputModule"));
     if (-1 != om->eventAutoFlushSize()) {
       eventTree_.setAutoFlush(-1*om->eventAutoFlushSize());
     }
@@ -156,11 +150,25 @@ namespace edm {
                            item.product_,
                            item.splitLevel_,
                            item.basketSize_,
+                           item.compression_,
                            item.branchDescription_->produced());
         //make sure we always store product registry info for all branches we create
         branchesWithStoredHistory_.insert(item.branchID());
       }
     }
+    //If we are dropping some of the meta data we need to know
+    // which BranchIDs were produced in this process because
+    // we may be storing meta data for only those products.
+    // The registry is frozen, so collect them once per file
+    // instead of once per event.
+    if(om_->dropMetaData() != PoolOutputModule::DropNone && om_->dropMetaData() != PoolOutputModule::DropAll) {
+      Service<ConstProductRegistry> preg;
+      for(auto bd : preg->allBranchDescriptions()) {
+        if(bd->produced() && bd->branchType() == InEvent) {
+          producedEventBranches_.insert(bd->branchID());
+        }
+      }
+    }
     // Don't split metadata tree or event description tree
     metaDataTree_         = RootOutputTree::makeTTree(filePtr_.get(), poolNames::metaDataTreeName(), 0);
     parentageTree_ = RootOutputTree::makeTTree(filePtr_.get(), poolNames::parentageTreeName(), 0);
@@ -698,20 +706,9 @@ namespace edm {
 
     bool const fastCloning = (branchType == InEvent) && (whyNotFastClonable_ == FileBlock::CanFastClone);
     std::set<StoredProductProvenance> provenanceToKeep;
-    //
-    //If we are dropping some of the meta data we need to know
-    // which BranchIDs were produced in this process because
-    // we may be storing meta data for only those products
-    // We do this only for event products.
-    std::set<BranchID> producedBranches;
-    if(doProvenance && branchType == InEvent && om_->dropMetaData() != PoolOutputModule::DropNone) {
-      Service<ConstProductRegistry> preg;
-      for(auto bd : preg->allBranchDescriptions()) {
-        if(bd->produced() && bd->branchType() == InEvent) {
-          producedBranches.insert(bd->branchID());
-        }
-      }
-    }
+    // The produced BranchIDs are used only for event products.
+    std::set<BranchID> const noProducedBranches;
+    std::set<BranchID> const& producedBranches = (branchType == InEvent) ? producedEventBranches_ : noProducedBranches;
 
     // Loop over EDProduct branches, possibly fill the provenance, and write the branch.
     for(auto const& item : items) {
@@ -141,6 +141,7 @@ namespace edm {
     ProcessHistoryRegistry processHistoryRegistry_;
     std::map<ParentageID,unsigned int> parentageIDs_;
     std::set<BranchID> branchesWithStoredHistory_;
+    std::set<BranchID> producedEventBranches_;
     edm::propagate_const<TClass*> wrapperBaseTClass_;
   };
 
@@ -333,6 +333,7 @@ namespace edm {
                             void const*& pProd,
                             int splitLevel,
                             int basketSize,
+                            int compression,
                             bool produced) {
       assert(splitLevel != BranchDescription::invalidSplitLevel);
       assert(basketSize != BranchDescription::invalidBasketSize);
@@ -342,6 +343,9 @@ namespace edm {
                  basketSize,
                  splitLevel);
       assert(branch != nullptr);
+      if(compression >= 0) {
+        branch->SetCompressionSettings(compression);
+      }
 /*
       if(pProd != nullptr) {
         // Delete the product that ROOT has allocated.
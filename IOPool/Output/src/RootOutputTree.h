@@ -68,6 +68,7 @@ namespace edm {
                    void const*& pProd,
                    int splitLevel,
                    int basketSize,
+                   int compression,
                    bool produced);
 
     bool checkSplitLevelsAndBasketSizes(TTree* inputTree) const;
@@ -0,0 +1,15 @@
+import FWCore.ParameterSet.Config as cms
+
+process = cms.Process("TESTOUTPUTREAD")
+process.load("FWCore.Framework.test.cmsExceptionsFatal_cff")
+
+process.maxEvents = cms.untracked.PSet(
+    input = cms.untracked.int32(-1)
+)
+process.source = cms.Source("PoolSource",
+    fileNames = cms.untracked.vstring('file:PoolCompressionTest.root')
+)
+
+process.Analysis = cms.EDAnalyzer("OtherThingAnalyzer")
+
+process.p = cms.Path(process.Analysis)
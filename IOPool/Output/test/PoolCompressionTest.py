@@ -0,0 +1,25 @@
+#!/usr/bin/env python
+# Checks the compression settings of the Events branches written by PoolCompressionTest_cfg.py,
+# in the ROOT encoding 100 * algorithm + level.
+from __future__ import print_function
+import sys
+import ROOT
+
+# LZ4 4 for the file, LZMA 9 for the branches of the OtherThing module
+expected = {"edmtestThings_Thing__TESTOUTPUT.": 404,
+            "edmtestOtherThings_OtherThing_testUserTag_TESTOUTPUT.": 209}
+
+tfile = ROOT.TFile.Open(sys.argv[1] if len(sys.argv) > 1 else "PoolCompressionTest.root")
+events = tfile.Get("Events")
+
+errors = 0
+for name, compression in sorted(expected.items()):
+    branch = events.GetBranch(name)
+    if not branch:
+        print("Missing the", name, "branch")
+        errors += 1
+    elif branch.GetCompressionSettings() != compression:
+        print(name, "compressed with", branch.GetCompressionSettings(), "instead of", compression)
+        errors += 1
+
+sys.exit(1 if errors else 0)
@@ -0,0 +1,29 @@
+import FWCore.ParameterSet.Config as cms
+
+process = cms.Process("TESTOUTPUT")
+process.load("FWCore.Framework.test.cmsExceptionsFatal_cff")
+
+process.maxEvents = cms.untracked.PSet(
+    input = cms.untracked.int32(20)
+)
+process.Thing = cms.EDProducer("ThingProducer")
+
+process.OtherThing = cms.EDProducer("OtherThingProducer")
+
+process.output = cms.OutputModule("PoolOutputModule",
+    fileName = cms.untracked.string('file:PoolCompressionTest.root'),
+    compressionAlgorithm = cms.untracked.string('LZ4'),
+    compressionLevel = cms.untracked.int32(4),
+    overrideBranchesCompression = cms.untracked.VPSet(
+        cms.untracked.PSet(
+            branch = cms.untracked.string('*_OtherThing_*_*'),
+            compressionAlgorithm = cms.untracked.string('LZMA'),
+            compressionLevel = cms.untracked.int32(9)
+        )
+    )
+)
+
+process.source = cms.Source("EmptySource")
+
+process.p = cms.Path(process.Thing*process.OtherThing)
+process.ep = cms.EndPath(process.output)
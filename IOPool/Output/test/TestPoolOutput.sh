@@ -16,6 +16,12 @@ cmsRun --parameter-set ${LOCAL_TEST_DIR}/PoolDropRead_cfg.py || die 'Failure usi
 
 cmsRun --parameter-set ${LOCAL_TEST_DIR}/PoolMissingRead_cfg.py || die 'Failure using PoolMissingRead_cfg.py' $?
 
+cmsRun --parameter-set ${LOCAL_TEST_DIR}/PoolCompressionTest_cfg.py || die 'Failure using PoolCompressionTest_cfg.py' $?
+
+python ${LOCAL_TEST_DIR}/PoolCompressionTest.py PoolCompressionTest.root || die 'Wrong compression settings in PoolCompressionTest.root' $?
+
+cmsRun --parameter-set ${LOCAL_TEST_DIR}/PoolCompressionRead_cfg.py || die 'Failure using PoolCompressionRead_cfg.py' $?
+
 cmsRun --parameter-set ${LOCAL_TEST_DIR}/PoolTransientTest_cfg.py || die 'Failure using PoolTransientTest_cfg.py' $?
 
 cmsRun --parameter-set ${LOCAL_TEST_DIR}/PoolTransientRead_cfg.py || die 'Failure using PoolTransientRead_cfg.py' $?
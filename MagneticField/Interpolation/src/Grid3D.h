@@ -24,6 +24,8 @@ struct BStorageArray {
 
   float v[3];
 };
+// grids are filled with a single binary_ifstream::read of 3*n floats
+static_assert(sizeof(BStorageArray) == 3*sizeof(float), "BStorageArray must be three packed floats");
 
 class dso_internal Grid3D {
 public:
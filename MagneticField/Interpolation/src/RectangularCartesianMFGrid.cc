@@ -34,14 +34,9 @@ RectangularCartesianMFGrid::RectangularCartesianMFGrid( binary_ifstream& inFile,
   double stepx, stepy, stepz;
   inFile >> stepx    >> stepy    >> stepz;
 
-  vector<BVector> fieldValues;
-  float Bx, By, Bz;
   int nLines = n1*n2*n3;
-  fieldValues.reserve(nLines);
-  for (int iLine=0; iLine<nLines; ++iLine){
-    inFile >> Bx >> By >> Bz;
-    fieldValues.push_back(BVector(Bx,By,Bz));
-  }
+  vector<BVector> fieldValues(nLines);
+  inFile.read(reinterpret_cast<float*>(fieldValues.data()), 3*nLines);
   // check completeness
   string lastEntry;
   inFile >> lastEntry;
@@ -33,20 +33,17 @@ SpecialCylindricalMFGrid::SpecialCylindricalMFGrid( binary_ifstream& inFile,
   double RParAsFunOfPhi[4];  // R = f(phi) or const. (0,2: const. par. ; 1,3: const./sin(phi));
   inFile >> RParAsFunOfPhi[0] >> RParAsFunOfPhi[1] >> RParAsFunOfPhi[2] >> RParAsFunOfPhi[3];
 
-  vector<BVector> fieldValues;
-  float Bx, By, Bz;
   int nLines = n1*n2*n3;
-  fieldValues.reserve(nLines);
-  for (int iLine=0; iLine<nLines; ++iLine){
-    inFile >> Bx >> By >> Bz;
+  vector<BVector> fieldValues(nLines);
+  inFile.read(reinterpret_cast<float*>(fieldValues.data()), 3*nLines);
+  for (auto& b : fieldValues) {
     // This would be fine only if local r.f. has the axes oriented as the global r.f.
     // For this volume we know that the local and global r.f. have different axis
     // orientation, so we do not try to be clever.
-    //    fieldValues.push_back(BVector(Bx,By,Bz));
-    
+
     // Preserve double precision!
-    Vector3DBase<double, LocalTag>  lB = frame().toLocal(Vector3DBase<double, GlobalTag>(Bx,By,Bz));
-    fieldValues.push_back(BVector(lB.x(), lB.y(), lB.z()));
+    Vector3DBase<double, LocalTag>  lB = frame().toLocal(Vector3DBase<double, GlobalTag>(b[0],b[1],b[2]));
+    b = BVector(lB.x(), lB.y(), lB.z());
   }
   // check completeness
   string lastEntry;
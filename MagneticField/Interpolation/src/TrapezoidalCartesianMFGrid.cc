@@ -61,19 +61,14 @@ TrapezoidalCartesianMFGrid::TrapezoidalCartesianMFGrid( binary_ifstream& inFile,
   inFile >> BasicDistance2[0][2] >> BasicDistance2[1][2] >> BasicDistance2[2][2];
   inFile >> easya >> easyb >> easyc;
 
-  vector<BVector> fieldValues;
-  float Bx, By, Bz;
   int nLines = n1*n2*n3;
-  fieldValues.reserve(nLines);
-  for (int iLine=0; iLine<nLines; ++iLine){
-    inFile >> Bx >> By >> Bz;
-    if (convertToLocal) {
+  vector<BVector> fieldValues(nLines);
+  inFile.read(reinterpret_cast<float*>(fieldValues.data()), 3*nLines);
+  if (convertToLocal) {
+    for (auto& b : fieldValues) {
       // Preserve double precision!
-      Vector3DBase<double, LocalTag>  lB = frame().toLocal(Vector3DBase<double, GlobalTag>(Bx,By,Bz));
-      fieldValues.push_back(BVector(lB.x(), lB.y(), lB.z()));
-      
-    } else {
-      fieldValues.push_back(BVector(Bx,By,Bz));
+      Vector3DBase<double, LocalTag>  lB = frame().toLocal(Vector3DBase<double, GlobalTag>(b[0],b[1],b[2]));
+      b = BVector(lB.x(), lB.y(), lB.z());
     }
   }
   // check completeness
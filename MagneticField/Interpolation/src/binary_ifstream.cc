@@ -64,6 +64,9 @@ binary_ifstream& binary_ifstream::operator>>( float& n) {
 binary_ifstream& binary_ifstream::operator>>( double& n) {
     fread( &n, sizeof(n), 1, file_); return *this;}
 
+binary_ifstream& binary_ifstream::read( float* buffer, std::size_t n) {
+    fread( buffer, sizeof(float), n, file_); return *this;}
+
 binary_ifstream& binary_ifstream::operator>>( bool& n) {
     n = static_cast<bool>(fgetc(file_));
     return *this;
@@ -3,6 +3,7 @@
 
 #include <string>
 #include <cstdio>
+#include <cstddef>
 #include "FWCore/Utilities/interface/Visibility.h"
 
 class binary_ifstream {
@@ -31,6 +32,9 @@ public:
     binary_ifstream& operator>>( bool& n);
     binary_ifstream& operator>>( std::string& n);
 
+  /// read n consecutive floats with a single call
+    binary_ifstream& read( float* buffer, std::size_t n);
+
     void close();
 
   /// stream state checking
@@ -16,7 +16,8 @@
 #include "TTree.h"
 #include "TROOT.h"
 #include "TObjString.h"
-#include "Compression.h"
+#include "TBranch.h"
+#include "TObjArray.h"
 
 // user include files
 #include "FWCore/Framework/interface/OutputModule.h"
@@ -30,6 +31,7 @@
 #include "FWCore/MessageLogger/interface/JobReport.h"
 #include "FWCore/Utilities/interface/GlobalIdentifier.h"
 #include "FWCore/Utilities/interface/Digest.h"
+#include "IOPool/Common/interface/BranchCompression.h"
 #include "IOPool/Provenance/interface/CommonProvenanceFiller.h"
 #include "DataFormats/Provenance/interface/BranchType.h"
 #include "DataFormats/Provenance/interface/BranchDescription.h"
@@ -56,6 +58,9 @@ private:
   bool isFileOpen() const override;
   void openFile(edm::FileBlock const&) override;
   void reallyCloseFile() override;
+  /// applies the per branch compression settings to the branches booked since the last call
+  void setBranchCompression();
+
 
   std::string m_fileName;
   std::string m_logicalFileName;
@@ -65,6 +70,8 @@ private:
   bool m_writeProvenance;
   bool m_fakeName; //crab workaround, remove after crab is fixed
   int m_autoFlush;
+  edm::SpecialCompressionForBranches m_specialCompressionForBranches;
+  int m_nBranchesWithCompressionSet{0};
   edm::ProcessHistoryRegistry m_processHistoryRegistry;
   edm::JobReport::Token m_jrToken;
   std::unique_ptr<TFile> m_file;
@@ -146,6 +153,7 @@ NanoAODOutputModule::NanoAODOutputModule(edm::ParameterSet const& pset):
   m_autoFlush(pset.getUntrackedParameter<int>("autoFlush", -10000000)),
   m_processHistoryRegistry()
 {
+  m_specialCompressionForBranches = edm::specialCompressionForBranches(pset, "NanoAODOutputModule");
 }
 
 NanoAODOutputModule::~NanoAODOutputModule()
@@ -198,6 +206,7 @@ NanoAODOutputModule::write(edm::EventForOutput const& iEvent) {
   }
   // fill triggers
   for (auto & t : m_triggers) t.fill(iEvent,*m_tree);
+  setBranchCompression();
   m_tree->Fill();
 
   m_processHistoryRegistry.registerProcessHistory(iEvent.processHistory());
@@ -240,6 +249,21 @@ NanoAODOutputModule::writeRun(edm::RunForOutput const& iRun) {
   m_processHistoryRegistry.registerProcessHistory(iRun.processHistory());
 }
 
+void
+NanoAODOutputModule::setBranchCompression() {
+  // the branches are booked from the content of the first event, and trigger branches can be added later on:
+  // only the new ones need to be looked at, before any of their baskets is written
+  if (m_specialCompressionForBranches.empty()) return;
+  TObjArray * branches = m_tree->GetListOfBranches();
+  int nBranches = branches->GetEntriesFast();
+  for (int i = m_nBranchesWithCompressionSet; i < nBranches; ++i) {
+    TBranch * branch = static_cast<TBranch *>(branches->UncheckedAt(i));
+    int compression = edm::specialCompression(m_specialCompressionForBranches, branch->GetName());
+    if (compression >= 0) branch->SetCompressionSettings(compression);
+  }
+  m_nBranchesWithCompressionSet = nBranches;
+}
+
 bool 
 NanoAODOutputModule::isFileOpen() const {
   return nullptr != m_file.get();
@@ -261,14 +285,7 @@ NanoAODOutputModule::openFile(edm::FileBlock const&) {
                                    std::vector<std::string>()
                                    );
 
-  if (m_compressionAlgorithm == std::string("ZLIB")) {
-      m_file->SetCompressionAlgorithm(ROOT::kZLIB);
-    } else if (m_compressionAlgorithm == std::string("LZMA")) {
-      m_file->SetCompressionAlgorithm(ROOT::kLZMA);
-    } else {
-      throw cms::Exception("Configuration") << "NanoAODOutputModule configured with unknown compression algorithm '" << m_compressionAlgorithm << "'\n"
-					     << "Allowed compression algorithms are ZLIB and LZMA\n";
-    }
+  m_file->SetCompressionAlgorithm(edm::compressionAlgorithmCode(m_compressionAlgorithm, "NanoAODOutputModule"));
   /* Setup file structure here */
   m_tables.clear();
   m_triggers.clear();
@@ -298,6 +315,7 @@ NanoAODOutputModule::openFile(edm::FileBlock const&) {
   m_tree->SetAutoSave(0);
   m_tree->SetAutoFlush(0);
   m_commonBranches.branch(*m_tree);
+  m_nBranchesWithCompressionSet = 0;
 
   m_lumiTree.reset(new TTree("LuminosityBlocks","LuminosityBlocks"));
   m_lumiTree->SetAutoSave(0);
@@ -349,13 +367,14 @@ NanoAODOutputModule::fillDescriptions(edm::ConfigurationDescriptions& descriptio
   desc.addUntracked<int>("compressionLevel", 9)
         ->setComment("ROOT compression level of output file.");
   desc.addUntracked<std::string>("compressionAlgorithm", "ZLIB")
-        ->setComment("Algorithm used to compress data in the ROOT output file, allowed values are ZLIB and LZMA");
+        ->setComment("Algorithm used to compress data in the ROOT output file, allowed values are ZLIB, LZMA, LZ4 and ZSTD (if supported by ROOT)");
   desc.addUntracked<bool>("saveProvenance", true)
         ->setComment("Save process provenance information, e.g. for edmProvDump");
   desc.addUntracked<bool>("fakeNameForCrab", false)
         ->setComment("Change the OutputModule name in the fwk job report to fake PoolOutputModule. This is needed to run on cran (and publish) till crab is fixed");
   desc.addUntracked<int>("autoFlush", -10000000)
         ->setComment("Autoflush parameter for ROOT file");
+  edm::fillSpecialCompressionDescription(desc);
 
   //replace with whatever you want to get from the EDM by default
   const std::vector<std::string> keep = {"drop *", "keep nanoaodFlatTable_*Table_*_*", "keep edmTriggerResults_*_*_*", "keep nanoaodMergeableCounterTable_*Table_*_*", "keep nanoaodUniqueString_nanoMetadata_*_*"};
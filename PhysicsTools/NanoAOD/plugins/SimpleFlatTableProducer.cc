@@ -19,16 +19,17 @@ class SimpleFlatTableProducerBase : public edm::stream::EDProducer<> {
             name_( params.getParameter<std::string>("name") ),
             doc_(params.existsAs<std::string>("doc") ? params.getParameter<std::string>("doc") : ""),
             extension_(params.existsAs<bool>("extension") ? params.getParameter<bool>("extension") : false),
+            compileCut_(params.getUntrackedParameter<std::string>("compileCut", "")),
             src_(consumes<TProd>( params.getParameter<edm::InputTag>("src") )) 
         {
             edm::ParameterSet const & varsPSet = params.getParameter<edm::ParameterSet>("variables");
             for (const std::string & vname : varsPSet.getParameterNamesForType<edm::ParameterSet>()) {
                 const auto & varPSet = varsPSet.getParameter<edm::ParameterSet>(vname);
                 const std::string & type = varPSet.getParameter<std::string>("type");
-                if (type == "int") vars_.push_back(new IntVar(vname, nanoaod::FlatTable::IntColumn, varPSet));
-                else if (type == "float") vars_.push_back(new FloatVar(vname, nanoaod::FlatTable::FloatColumn, varPSet));
-                else if (type == "uint8") vars_.push_back(new UInt8Var(vname, nanoaod::FlatTable::UInt8Column, varPSet));
-                else if (type == "bool") vars_.push_back(new BoolVar(vname, nanoaod::FlatTable::BoolColumn, varPSet));
+                if (type == "int") vars_.push_back(new IntVar(vname, nanoaod::FlatTable::IntColumn, varPSet, compileCut_));
+                else if (type == "float") vars_.push_back(new FloatVar(vname, nanoaod::FlatTable::FloatColumn, varPSet, compileCut_));
+                else if (type == "uint8") vars_.push_back(new UInt8Var(vname, nanoaod::FlatTable::UInt8Column, varPSet, compileCut_));
+                else if (type == "bool") vars_.push_back(new BoolVar(vname, nanoaod::FlatTable::BoolColumn, varPSet, compileCut_));
                 else throw cms::Exception("Configuration", "unsupported type "+type+" for variable "+vname);
             }
 
@@ -55,6 +56,8 @@ class SimpleFlatTableProducerBase : public edm::stream::EDProducer<> {
         const std::string name_; 
         const std::string doc_;
         const bool extension_;
+        // package to compile the expressions against, see StringCutObjectSelector; empty to use reflection
+        const std::string compileCut_;
         const edm::EDGetTokenT<TProd> src_;
 
         class VariableBase {
@@ -76,19 +79,18 @@ class SimpleFlatTableProducerBase : public edm::stream::EDProducer<> {
             public:
                 Variable(const std::string & aname, nanoaod::FlatTable::ColumnType atype, const edm::ParameterSet & cfg) : 
                     VariableBase(aname, atype, cfg) {}
-                virtual void fill(std::vector<const T *> selobjs, nanoaod::FlatTable & out) const = 0;
+                virtual void fill(const std::vector<const T *> & selobjs, nanoaod::FlatTable & out) const = 0;
         };
         template<typename StringFunctor, typename ValType>
             class FuncVariable : public Variable {
                 public:
-                    FuncVariable(const std::string & aname, nanoaod::FlatTable::ColumnType atype, const edm::ParameterSet & cfg) :
-                        Variable(aname, atype, cfg), func_(cfg.getParameter<std::string>("expr"), true) {}
+                    FuncVariable(const std::string & aname, nanoaod::FlatTable::ColumnType atype, const edm::ParameterSet & cfg,
+                                 const std::string & compilePackage) :
+                        Variable(aname, atype, cfg), func_(cfg.getParameter<std::string>("expr"), true, compilePackage) {}
                     ~FuncVariable() override {}
-                    void fill(std::vector<const T *> selobjs, nanoaod::FlatTable & out) const override {
-                        std::vector<ValType> vals(selobjs.size());
-                        for (unsigned int i = 0, n = vals.size(); i < n; ++i) {
-                            vals[i] = func_(*selobjs[i]);
-                        }
+                    void fill(const std::vector<const T *> & selobjs, nanoaod::FlatTable & out) const override {
+                        std::vector<ValType> vals;
+                        func_.evaluate(selobjs, vals);
                         out.template addColumn<ValType>(this->name_, vals, this->doc_, this->type_,this->precision_);
                     }
                 protected:
@@ -111,7 +113,7 @@ class SimpleFlatTableProducer : public SimpleFlatTableProducerBase<T, edm::View<
             SimpleFlatTableProducerBase<T, edm::View<T>>(params),
             singleton_(params.getParameter<bool>("singleton")),
             maxLen_(params.existsAs<unsigned int>("maxLen") ? params.getParameter<unsigned int>("maxLen") : std::numeric_limits<unsigned int>::max()),
-            cut_(!singleton_ ? params.getParameter<std::string>("cut") : "", true) 
+            cut_(!singleton_ ? params.getParameter<std::string>("cut") : "", true, this->compileCut_)
         {
             if (params.existsAs<edm::ParameterSet>("externalVariables")) {
                 edm::ParameterSet const & extvarsPSet = params.getParameter<edm::ParameterSet>("externalVariables");
@@ -138,10 +140,14 @@ class SimpleFlatTableProducer : public SimpleFlatTableProducerBase<T, edm::View<
                 selobjs.push_back(& (*prod)[0] );
                 if (!extvars_.empty()) selptrs.emplace_back(prod->ptrAt(0));
             } else {
-                for (unsigned int i = 0, n = prod->size(); i < n; ++i) {
-                    const auto & obj = (*prod)[i];
-                    if (cut_(obj)) { 
-                        selobjs.push_back(&obj); 
+                std::vector<const T *> allobjs;
+                allobjs.reserve(prod->size());
+                for (const auto & obj : *prod) allobjs.push_back(&obj);
+                std::vector<uint8_t> passed;
+                cut_.evaluate(allobjs, passed);
+                for (unsigned int i = 0, n = allobjs.size(); i < n; ++i) {
+                    if (passed[i]) { 
+                        selobjs.push_back(allobjs[i]); 
                         if (!extvars_.empty()) selptrs.emplace_back(prod->ptrAt(i));
                     }
 		    if(selobjs.size()>=maxLen_) break;
@@ -0,0 +1,24 @@
+#!/usr/bin/env python
+# Checks the compression settings of the branches written by testBranchCompression_cfg.py,
+# in the ROOT encoding 100 * algorithm + level.
+from __future__ import print_function
+import sys
+import ROOT
+
+# LZMA 9 for the file, LZ4 4 for GenPart_* and ZLIB 3 for GenPart_eta
+expected = {"nGenPart": 209, "GenPart_pt": 404, "GenPart_phi": 404, "GenPart_eta": 103, "event": 209}
+
+tfile = ROOT.TFile.Open(sys.argv[1] if len(sys.argv) > 1 else "testBranchCompression.root")
+events = tfile.Get("Events")
+
+errors = 0
+for name, compression in sorted(expected.items()):
+    branch = events.GetBranch(name)
+    if not branch:
+        print("Missing the", name, "branch")
+        errors += 1
+    elif branch.GetCompressionSettings() != compression:
+        print(name, "compressed with", branch.GetCompressionSettings(), "instead of", compression)
+        errors += 1
+
+sys.exit(1 if errors else 0)
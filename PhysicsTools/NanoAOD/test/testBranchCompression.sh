@@ -0,0 +1,6 @@
+#!/bin/sh
+
+function die { echo $1: status $2 ;  exit $2; }
+
+cmsRun ${LOCAL_TEST_DIR}/testBranchCompression_cfg.py > testBranchCompression.log 2>&1 || { cat testBranchCompression.log; die 'Failure running testBranchCompression_cfg.py' 1; }
+python ${LOCAL_TEST_DIR}/testBranchCompression.py testBranchCompression.root || die 'Wrong compression settings of the branches' $?
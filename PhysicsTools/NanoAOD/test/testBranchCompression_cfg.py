@@ -0,0 +1,66 @@
+import FWCore.ParameterSet.Config as cms
+from PhysicsTools.NanoAOD.common_cff import Var, CandVars
+
+# Writes a table of generated particles with per branch compression settings.
+# testBranchCompression.py then checks the compression settings of the branches.
+
+process = cms.Process("TEST")
+
+process.load("FWCore.MessageService.MessageLogger_cfi")
+
+process.load("SimGeneral.HepPDTESSource.pythiapdt_cfi")
+process.RandomNumberGeneratorService = cms.Service("RandomNumberGeneratorService",
+    generator = cms.PSet(initialSeed = cms.untracked.uint32(123456789))
+)
+
+process.source = cms.Source("EmptySource")
+process.maxEvents = cms.untracked.PSet(input = cms.untracked.int32(10))
+
+process.generator = cms.EDProducer("FlatRandomPtGunProducer",
+    PGunParameters = cms.PSet(
+        PartID = cms.vint32(11, 13),
+        MinEta = cms.double(-3.0),
+        MaxEta = cms.double(3.0),
+        MinPhi = cms.double(-3.14159265359),
+        MaxPhi = cms.double(3.14159265359),
+        MinPt  = cms.double(5.),
+        MaxPt  = cms.double(100.)
+    ),
+    Verbosity       = cms.untracked.int32(0),
+    AddAntiParticle = cms.bool(True)
+)
+
+process.load("PhysicsTools.HepMCCandAlgos.genParticles_cfi")
+process.genParticles.src = "generator:unsmeared"
+
+process.genTable = cms.EDProducer("SimpleCandidateFlatTableProducer",
+    src = cms.InputTag("genParticles"),
+    cut = cms.string(""),
+    name = cms.string("GenPart"),
+    doc = cms.string("generated particles"),
+    singleton = cms.bool(False),
+    extension = cms.bool(False),
+    variables = cms.PSet(CandVars)
+)
+
+process.out = cms.OutputModule("NanoAODOutputModule",
+    fileName = cms.untracked.string("testBranchCompression.root"),
+    compressionAlgorithm = cms.untracked.string("LZMA"),
+    compressionLevel = cms.untracked.int32(9),
+    overrideBranchesCompression = cms.untracked.VPSet(
+        cms.PSet(
+            branch = cms.untracked.string("GenPart_*"),
+            compressionAlgorithm = cms.untracked.string("LZ4"),
+            compressionLevel = cms.untracked.int32(4)
+        ),
+        # the last matching entry is used
+        cms.PSet(
+            branch = cms.untracked.string("GenPart_e?a"),
+            compressionAlgorithm = cms.untracked.string("ZLIB"),
+            compressionLevel = cms.untracked.int32(3)
+        )
+    )
+)
+
+process.p = cms.Path(process.generator + process.genParticles + process.genTable)
+process.e = cms.EndPath(process.out)
@@ -0,0 +1,41 @@
+#!/usr/bin/env python
+# Checks that the tables written by testCompiledCut_cfg.py with compileCut are identical
+# to those of the reflection based string parser.
+from __future__ import print_function
+import sys
+import ROOT
+
+pairs = [("ReflectionSelected", "CompiledSelected"), ("ReflectionCut", "CompiledCut")]
+
+tfile = ROOT.TFile.Open(sys.argv[1] if len(sys.argv) > 1 else "testCompiledCut.root")
+events = tfile.Get("Events")
+branches = [b.GetName() for b in events.GetListOfBranches()]
+
+errors = 0
+for reference, compiled in pairs:
+    columns = [b[len(reference) + 1:] for b in branches if b.startswith(reference + "_")]
+    if not columns or "n" + compiled not in branches:
+        print("Missing the", reference, "or", compiled, "table")
+        sys.exit(1)
+    nSelected, nAll = 0, 0
+    for i, event in enumerate(events):
+        n = getattr(event, "n" + reference)
+        if n != getattr(event, "n" + compiled):
+            print("Event", i, ":", n, reference, "objects but", getattr(event, "n" + compiled), compiled)
+            errors += 1
+            continue
+        nSelected += n
+        nAll += event.nAll
+        for column in columns:
+            ref = getattr(event, reference + "_" + column)
+            com = getattr(event, compiled + "_" + column)
+            for j in range(n):
+                if ref[j] != com[j]:
+                    print("Event", i, compiled + "_" + column, "[", j, "]:", com[j], "instead of", ref[j])
+                    errors += 1
+    if nSelected == 0 or nSelected == nAll:
+        print(nSelected, "of the", nAll, "objects selected in", reference, ", the cut is not tested")
+        sys.exit(1)
+    print(reference, "and", compiled, "agree on", nSelected, "objects and", len(columns), "columns")
+
+sys.exit(1 if errors else 0)
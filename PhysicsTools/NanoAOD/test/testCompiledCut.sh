@@ -0,0 +1,10 @@
+#!/bin/sh
+
+function die { echo $1: status $2 ;  exit $2; }
+
+cmsRun ${LOCAL_TEST_DIR}/testCompiledCut_cfg.py > testCompiledCut.log 2>&1 || { cat testCompiledCut.log; die 'Failure running testCompiledCut_cfg.py' 1; }
+if grep -q "using the reflection based evaluation" testCompiledCut.log; then
+  cat testCompiledCut.log
+  die 'An expression with compileCut was not compiled' 1
+fi
+python ${LOCAL_TEST_DIR}/testCompiledCut.py testCompiledCut.root || die 'The compiled and reflection based selections differ' $?
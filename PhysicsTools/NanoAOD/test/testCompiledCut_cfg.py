@@ -0,0 +1,97 @@
+import FWCore.ParameterSet.Config as cms
+from PhysicsTools.NanoAOD.common_cff import Var, CandVars
+
+# Selects and stores the same generated particles twice, through the reflection based string
+# parser and with compileCut, in a CandViewSelector and in SimpleCandidateFlatTableProducers.
+# testCompiledCut.py then checks that the tables are identical.
+
+process = cms.Process("TEST")
+
+process.load("FWCore.MessageService.MessageLogger_cfi")
+# reports an expression which could not be compiled
+process.MessageLogger.categories.append("StringExpressionCompilation")
+process.MessageLogger.cerr.StringExpressionCompilation = cms.untracked.PSet(limit = cms.untracked.int32(-1))
+
+process.load("SimGeneral.HepPDTESSource.pythiapdt_cfi")
+process.RandomNumberGeneratorService = cms.Service("RandomNumberGeneratorService",
+    generator = cms.PSet(initialSeed = cms.untracked.uint32(123456789))
+)
+
+process.source = cms.Source("EmptySource")
+process.maxEvents = cms.untracked.PSet(input = cms.untracked.int32(50))
+
+process.generator = cms.EDProducer("FlatRandomPtGunProducer",
+    PGunParameters = cms.PSet(
+        PartID = cms.vint32(11, 13, 22, 211),
+        MinEta = cms.double(-3.0),
+        MaxEta = cms.double(3.0),
+        MinPhi = cms.double(-3.14159265359),
+        MaxPhi = cms.double(3.14159265359),
+        MinPt  = cms.double(5.),
+        MaxPt  = cms.double(100.)
+    ),
+    Verbosity       = cms.untracked.int32(0),
+    AddAntiParticle = cms.bool(True)
+)
+
+process.load("PhysicsTools.HepMCCandAlgos.genParticles_cfi")
+process.genParticles.src = "generator:unsmeared"
+
+cut = "pt > 20 && abs(eta) < 2.4 || abs(pdgId) == 13 && !(charge > 0)"
+compilePackage = cms.untracked.string("CommonTools/CandUtils")
+
+process.reflectionSelected = cms.EDFilter("CandViewSelector",
+    src = cms.InputTag("genParticles"),
+    cut = cms.string(cut)
+)
+process.compiledSelected = process.reflectionSelected.clone(compileCut = compilePackage)
+
+variables = cms.PSet(CandVars,
+    energy = Var("energy", float),
+    central = Var("abs(eta) < 1.5 && pt > 30", bool),
+    ptOverE = Var("sqrt(px*px + py*py) / energy", float),
+)
+process.reflectionSelectedTable = cms.EDProducer("SimpleCandidateFlatTableProducer",
+    src = cms.InputTag("reflectionSelected"),
+    cut = cms.string(""),
+    name = cms.string("ReflectionSelected"),
+    doc = cms.string("selected by the reflection based CandViewSelector"),
+    singleton = cms.bool(False),
+    extension = cms.bool(False),
+    variables = variables
+)
+process.compiledSelectedTable = process.reflectionSelectedTable.clone(
+    src = "compiledSelected",
+    name = "CompiledSelected",
+    doc = "selected by the compiled CandViewSelector",
+    compileCut = compilePackage
+)
+process.reflectionCutTable = process.reflectionSelectedTable.clone(
+    src = "genParticles",
+    cut = cut,
+    name = "ReflectionCut",
+    doc = "selected by the reflection based table cut"
+)
+process.compiledCutTable = process.reflectionCutTable.clone(
+    name = "CompiledCut",
+    doc = "selected by the compiled table cut",
+    compileCut = compilePackage
+)
+
+# the number of particles before the selection
+process.allTable = process.reflectionCutTable.clone(
+    cut = "",
+    name = "All",
+    doc = "all the generated particles",
+    variables = cms.PSet()
+)
+
+process.out = cms.OutputModule("NanoAODOutputModule",
+    fileName = cms.untracked.string("testCompiledCut.root")
+)
+
+process.p = cms.Path(process.generator + process.genParticles +
+                     process.reflectionSelected + process.compiledSelected +
+                     process.reflectionSelectedTable + process.compiledSelectedTable +
+                     process.reflectionCutTable + process.compiledCutTable + process.allTable)
+process.e = cms.EndPath(process.out)
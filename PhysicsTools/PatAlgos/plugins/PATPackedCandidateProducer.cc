@@ -212,6 +212,8 @@ void pat::PATPackedCandidateProducer::produce(edm::StreamID, edm::Event& iEvent,
     edm::Handle<reco::TrackCollection> TKOrigs;
     iEvent.getByToken( TKOrigs_, TKOrigs );
     auto outPtrP = std::make_unique<std::vector<pat::PackedCandidate>>();
+    // the move constructor of PackedCandidate is not noexcept, a reallocation would copy (and unpack) all the candidates
+    outPtrP->reserve(cands->size());
     std::vector<int> mapping(cands->size());
     std::vector<int> mappingReverse(cands->size());
     std::vector<int> mappingTk(TKOrigs->size(), -1);
@@ -256,7 +258,7 @@ void pat::PATPackedCandidateProducer::produce(edm::StreamID, edm::Event& iEvent,
           }
 
 	  
-          outPtrP->push_back( pat::PackedCandidate(cand.polarP4(), vtx, ptTrk, etaAtVtx, phiAtVtx, cand.pdgId(), PVRefProd, PV.key()));
+          outPtrP->emplace_back(cand.polarP4(), vtx, ptTrk, etaAtVtx, phiAtVtx, cand.pdgId(), PVRefProd, PV.key());
           outPtrP->back().setAssociationQuality(pat::PackedCandidate::PVAssociationQuality(qualityMap[quality]));
           outPtrP->back().setCovarianceVersion(covarianceVersion_);
           if(cand.trackRef().isNonnull() && PVOrig.isNonnull() && PVOrig->trackWeight(cand.trackRef()) > 0.5 && quality == 7) {
@@ -299,7 +301,7 @@ void pat::PATPackedCandidateProducer::produce(edm::StreamID, edm::Event& iEvent,
             PVpos = PV->position();
           }
 	
-          outPtrP->push_back( pat::PackedCandidate(cand.polarP4(), PVpos, cand.pt(), cand.eta(), cand.phi(), cand.pdgId(), PVRefProd, PV.key()));
+          outPtrP->emplace_back(cand.polarP4(), PVpos, cand.pt(), cand.eta(), cand.phi(), cand.pdgId(), PVRefProd, PV.key());
           outPtrP->back().setAssociationQuality(pat::PackedCandidate::PVAssociationQuality(pat::PackedCandidate::UsedInFitTight));
         }
     
@@ -370,8 +372,10 @@ void pat::PATPackedCandidateProducer::produce(edm::StreamID, edm::Event& iEvent,
     auto outPtrPSorted = std::make_unique<std::vector<pat::PackedCandidate>>();
     std::vector<size_t> order=sort_indexes(*outPtrP);
     std::vector<size_t> reverseOrder(order.size());
+    outPtrPSorted->reserve(order.size());
     for(size_t i=0,nc=cands->size();i<nc;i++) {
-        outPtrPSorted->push_back((*outPtrP)[order[i]]);
+        // outPtrP is not used anymore, move the unpacked caches instead of copying them
+        outPtrPSorted->push_back(std::move((*outPtrP)[order[i]]));
         reverseOrder[order[i]] = i;
         mappingReverse[order[i]]=i;
     }
@@ -21,6 +21,12 @@ buildClusters(const edm::Handle<reco::PFRecHitCollection>& input,
   auto const & hits = *input;  
   std::vector<bool> used(hits.size(),false);
   std::vector<unsigned int> seeds;
+
+  // evaluate the gathering thresholds once per hit instead of once per visit
+  _aboveThreshold.assign(hits.size(),false);
+  for( unsigned int i = 0; i < hits.size(); ++i ) {
+    if( rechitMask[i] ) _aboveThreshold[i] = passesGatheringThreshold(hits[i]);
+  }
   
   // get the seeds and sort them descending in energy
   seeds.reserve(hits.size());  
@@ -41,13 +47,8 @@ buildClusters(const edm::Handle<reco::PFRecHitCollection>& input,
   }
 }
 
-void Basic2DGenericTopoClusterizer::
-buildTopoCluster(const edm::Handle<reco::PFRecHitCollection>& input,
-		 const std::vector<bool>& rechitMask,
-		 unsigned int kcell,
-		 std::vector<bool>& used,		 
-		 reco::PFCluster& topocluster) {
-  auto const & cell = (*input)[kcell];
+bool Basic2DGenericTopoClusterizer::
+passesGatheringThreshold(const reco::PFRecHit& cell) const {
   int cell_layer = (int)cell.layer();
   if( cell_layer == PFLayer::HCAL_BARREL2 && 
       std::abs(cell.positionREP().eta()) > 0.34 ) {
@@ -73,19 +74,37 @@ buildTopoCluster(const edm::Handle<reco::PFRecHitCollection>& input,
     LOGDRESSED("GenericTopoCluster::buildTopoCluster()")
       << "RecHit " << cell.detId() << " with enegy "
       << cell.energy() << " GeV was rejected!." << std::endl;
-    return;
+    return false;
   }
+  return true;
+}
 
+// depth-first traversal with an explicit stack; the visiting order (and
+// hence the order of the rechit fractions) is the same as for the former
+// recursive implementation
+void Basic2DGenericTopoClusterizer::
+buildTopoCluster(const edm::Handle<reco::PFRecHitCollection>& input,
+		 const std::vector<bool>& rechitMask,
+		 unsigned int kcell,
+		 std::vector<bool>& used,		 
+		 reco::PFCluster& topocluster) {
+  auto const & hits = *input;
+  if( !_aboveThreshold[kcell] ) return;
 
-  auto k = kcell;
-  used[k] = true;
-  auto ref = makeRefhit(input,k);
-  topocluster.addRecHitFraction(reco::PFRecHitFraction(ref, 1.0));
-  
-  auto const & neighbours = 
-    ( _useCornerCells ? cell.neighbours8() : cell.neighbours4() );
-  
-  for( auto nb : neighbours ) {
+  _stack.clear();
+  used[kcell] = true;
+  topocluster.addRecHitFraction(reco::PFRecHitFraction(makeRefhit(input,kcell), 1.0));
+  _stack.emplace_back(kcell,0);
+
+  while( !_stack.empty() ) {
+    auto const & cell = hits[_stack.back().first];
+    auto const & neighbours = 
+      ( _useCornerCells ? cell.neighbours8() : cell.neighbours4() );
+    if( _stack.back().second == neighbours.size() ) {
+      _stack.pop_back();
+      continue;
+    }
+    auto nb = *(neighbours.begin() + _stack.back().second++);
     if( used[nb] || !rechitMask[nb] ) {
       LOGDRESSED("GenericTopoCluster::buildTopoCluster()")
       	<< "  RecHit " << cell.detId() << "\'s" 
@@ -96,6 +115,9 @@ buildTopoCluster(const edm::Handle<reco::PFRecHitCollection>& input,
 	<< !rechitMask[nb] << " (masked)." << std::endl;
       continue;
     }
-    buildTopoCluster(input,rechitMask,nb,used,topocluster);
+    if( !_aboveThreshold[nb] ) continue;
+    used[nb] = true;
+    topocluster.addRecHitFraction(reco::PFRecHitFraction(makeRefhit(input,nb), 1.0));
+    _stack.emplace_back(nb,0);
   }
 }
@@ -4,6 +4,9 @@
 #include "RecoParticleFlow/PFClusterProducer/interface/InitialClusteringStepBase.h"
 #include "DataFormats/ParticleFlowReco/interface/PFRecHitFraction.h"
 
+#include <utility>
+#include <vector>
+
 class Basic2DGenericTopoClusterizer : public InitialClusteringStepBase {
   typedef Basic2DGenericTopoClusterizer B2DGT;
  public:
@@ -22,6 +25,11 @@ class Basic2DGenericTopoClusterizer : public InitialClusteringStepBase {
   
  private:  
   const bool _useCornerCells;
+  // per-event scratch: gathering threshold decision per rechit and the
+  // explicit (hit, next neighbour) stack replacing the recursion
+  std::vector<bool> _aboveThreshold;
+  std::vector<std::pair<unsigned int,unsigned int> > _stack;
+  bool passesGatheringThreshold(const reco::PFRecHit&) const;
   void buildTopoCluster(const edm::Handle<reco::PFRecHitCollection>&,
 			const std::vector<bool>&, // masked rechits
 			unsigned int, //present rechit
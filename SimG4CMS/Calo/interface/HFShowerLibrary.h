@@ -21,6 +21,7 @@
 
 #include <string>
 #include <memory>
+#include <vector>
 
 class DDCompactView;    
 class G4Step;
@@ -54,6 +55,7 @@ protected:
 
   bool                rInside(double r);
   void                getRecord(int, int);
+  void                readRecord(TBranch *, int);
   void                loadEventInfo(TBranch *);
   void                interpolate(int, double);
   void                extrapolate(int, double);
@@ -63,6 +65,15 @@ protected:
 
 private:
 
+  // photons of all records of both branches kept in memory; built once
+  // per library file and shared by all instances (threads)
+  struct Cache {
+    std::vector<HFShowerPhoton> photons;
+    std::vector<unsigned int>   emOffset, hadOffset;
+  };
+  std::shared_ptr<const Cache> loadCache(const std::string &);
+  void                fillCache(TBranch *, Cache &, std::vector<unsigned int> &);
+
   HFFibre *           fibre;
   TFile *             hf;
   TBranch             *emBranch, *hadBranch;
@@ -80,6 +91,7 @@ private:
   HFShowerPhotonCollection pe;
   HFShowerPhotonCollection* photo;
   HFShowerPhotonCollection photon;
+  std::shared_ptr<const Cache> cache;
 
 };
 #endif
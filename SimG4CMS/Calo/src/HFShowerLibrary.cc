@@ -11,6 +11,7 @@
 #include "SimG4Core/Notification/interface/G4TrackToParticleID.h"
 
 #include "FWCore/Utilities/interface/Exception.h"
+#include "FWCore/Utilities/interface/thread_safety_macros.h"
 
 #include "G4VPhysicalVolume.hh"
 #include "G4NavigationHistory.hh"
@@ -21,6 +22,9 @@
 #include "CLHEP/Units/SystemOfUnits.h"
 #include "CLHEP/Units/PhysicalConstants.h"
 
+#include <map>
+#include <mutex>
+
 //#define DebugLog
 
 HFShowerLibrary::HFShowerLibrary(const std::string & name, const DDCompactView & cpv,
@@ -44,6 +48,7 @@ HFShowerLibrary::HFShowerLibrary(const std::string & name, const DDCompactView &
   std::string branchPost   = m_HS.getUntrackedParameter<std::string>("BranchPost","_R.obj");
   verbose                  = m_HS.getUntrackedParameter<bool>("Verbosity",false);
   applyFidCut              = m_HS.getParameter<bool>("ApplyFiducialCut");
+  bool cacheInMemory       = m_HS.getUntrackedParameter<bool>("CacheInMemory",false);
 
   if (pTreeName.find(".") == 0) pTreeName.erase(0,2);
   const char* nTree = pTreeName.c_str();
@@ -119,6 +124,16 @@ HFShowerLibrary::HFShowerLibrary(const std::string & name, const DDCompactView &
   
   fibre = new HFFibre(name, cpv, p);
   photo = new HFShowerPhotonCollection;
+
+  if (cacheInMemory) {
+    cache = loadCache(pTreeName + ":" + emBranch->GetName() + ":" + 
+                      hadBranch->GetName());
+    edm::LogInfo("HFShower") << "HFShowerLibrary: uses in-memory copy with "
+                             << cache->photons.size() << " photons in "
+                             << cache->emOffset.size()-1 << " EM and "
+                             << cache->hadOffset.size()-1 << " hadronic "
+                             << "records";
+  }
 }
 
 HFShowerLibrary::~HFShowerLibrary() {
@@ -370,48 +385,18 @@ void HFShowerLibrary::getRecord(int type, int record) {
   int nrc     = record-1;
   photon.clear();
   photo->clear();
-  if (type > 0) {
-    if (newForm) {
-      if ( !v3version ) {
-        hadBranch->SetAddress(&photo);
-        hadBranch->GetEntry(nrc+totEvents);
-      }
-      else{
-        std::vector<float> t;
-        std::vector<float> *tp=&t;
-        hadBranch->SetAddress(&tp);
-        hadBranch->GetEntry(nrc+totEvents);
-        unsigned int tSize=t.size()/5;
-        photo->reserve(tSize);
-        for ( unsigned int i=0; i<tSize; i++ ) {
-          photo->push_back( HFShowerPhoton( t[i], t[1*tSize+i], t[2*tSize+i], t[3*tSize+i], t[4*tSize+i] ) );
-        }
-      }
-    } else {
-      hadBranch->SetAddress(&photon);
-      hadBranch->GetEntry(nrc);
+  TBranch * branch = (type > 0) ? hadBranch : emBranch;
+  int entry = (type > 0 && newForm) ? nrc+totEvents : nrc;
+  if (cache) {
+    const std::vector<unsigned int>& offset = (type > 0) ? cache->hadOffset :
+      cache->emOffset;
+    if (entry >= 0 && entry+1 < (int)(offset.size())) {
+      HFShowerPhotonCollection & out = (newForm) ? *photo : photon;
+      out.assign(cache->photons.begin()+offset[entry], 
+                 cache->photons.begin()+offset[entry+1]);
     }
   } else {
-    if (newForm) {
-      if (!v3version) {
-        emBranch->SetAddress(&photo);
-        emBranch->GetEntry(nrc);
-      }
-      else{
-        std::vector<float> t;
-        std::vector<float> *tp=&t;
-        emBranch->SetAddress(&tp);
-        emBranch->GetEntry(nrc);
-        unsigned int tSize=t.size()/5;
-        photo->reserve(tSize);
-        for ( unsigned int i=0; i<tSize; i++ ) {
-          photo->push_back( HFShowerPhoton( t[i], t[1*tSize+i], t[2*tSize+i], t[3*tSize+i], t[4*tSize+i] ) );
-        }
-      }
-    } else {
-      emBranch->SetAddress(&photon);
-      emBranch->GetEntry(nrc);
-    }
+    readRecord(branch, entry);
   }
 #ifdef DebugLog
   int nPhoton = (newForm) ? photo->size() : photon.size();
@@ -424,6 +409,65 @@ void HFShowerLibrary::getRecord(int type, int record) {
 #endif
 }
 
+void HFShowerLibrary::readRecord(TBranch* branch, int entry) {
+
+  if (newForm) {
+    if (!v3version) {
+      branch->SetAddress(&photo);
+      branch->GetEntry(entry);
+    } else {
+      std::vector<float> t;
+      std::vector<float> *tp=&t;
+      branch->SetAddress(&tp);
+      branch->GetEntry(entry);
+      unsigned int tSize=t.size()/5;
+      photo->reserve(tSize);
+      for ( unsigned int i=0; i<tSize; i++ ) {
+        photo->push_back( HFShowerPhoton( t[i], t[1*tSize+i], t[2*tSize+i], t[3*tSize+i], t[4*tSize+i] ) );
+      }
+    }
+  } else {
+    branch->SetAddress(&photon);
+    branch->GetEntry(entry);
+  }
+}
+
+std::shared_ptr<const HFShowerLibrary::Cache> 
+HFShowerLibrary::loadCache(const std::string & key) {
+
+  static std::mutex mutex;
+  CMS_THREAD_GUARD(mutex) static std::map<std::string, std::weak_ptr<const Cache> > caches;
+
+  std::lock_guard<std::mutex> guard(mutex);
+  std::shared_ptr<const Cache> result = caches[key].lock();
+  if (!result) {
+    auto filled = std::make_shared<Cache>();
+    fillCache(emBranch, *filled, filled->emOffset);
+    fillCache(hadBranch, *filled, filled->hadOffset);
+    photon.clear();
+    photo->clear();
+    result = filled;
+    caches[key] = result;
+  }
+  return result;
+}
+
+void HFShowerLibrary::fillCache(TBranch* branch, Cache & filled,
+                                std::vector<unsigned int> & offset) {
+
+  int nEntries = branch->GetEntries();
+  offset.reserve(nEntries+1);
+  offset.push_back(filled.photons.size());
+  for (int entry = 0; entry < nEntries; ++entry) {
+    photon.clear();
+    photo->clear();
+    readRecord(branch, entry);
+    const HFShowerPhotonCollection & in = (newForm) ? *photo : photon;
+    filled.photons.insert(filled.photons.end(), in.begin(), in.end());
+    offset.push_back(filled.photons.size());
+  }
+}
+
 void HFShowerLibrary::loadEventInfo(TBranch* branch) {
 
   if (branch) {
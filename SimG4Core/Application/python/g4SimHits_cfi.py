@@ -353,6 +353,7 @@ g4SimHits = cms.EDProducer("OscarMTProducer",
         TreeHadID       = cms.string('hadParticles'),
         Verbosity       = cms.untracked.bool(False),
         ApplyFiducialCut= cms.bool(True),
+        CacheInMemory   = cms.untracked.bool(False),
         BranchPost      = cms.untracked.string(''),
         BranchEvt       = cms.untracked.string(''),
         BranchPre       = cms.untracked.string('')
@@ -28,6 +28,7 @@
 #include "PreMixingPileupCopy.h"
 
 #include <functional>
+#include <string>
 #include <vector>
 
 namespace edm {
@@ -93,6 +94,17 @@ namespace edm {
       std::string type = pset.getParameter<std::string>("workerType");
       workers_.emplace_back(PreMixingWorkerFactory::get()->create(type, pset, *this, consumesCollector()));
     }
+
+    // Optionally restrict the premixed pileup input to the branches the
+    // workers actually read, given as "friendlyClassName_label_instance"
+    // patterns. Everything else is dropped on input.
+    const auto& wantedBranches = ps.getUntrackedParameter<std::vector<std::string> >("pileupInputBranches", std::vector<std::string>());
+    if(!wantedBranches.empty()) {
+      for(const auto& branch: wantedBranches) {
+        LogDebug("PreMixingModule") << "Will keep branch " << branch << " for premixing";
+      }
+      dropUnwantedBranches(wantedBranches);
+    }
   }
 
 
@@ -74,6 +74,9 @@ mixData = cms.EDProducer("PreMixingModule",
     maxBunch = cms.int32(0),
     mixProdStep1 = cms.bool(False),
     mixProdStep2 = cms.bool(False),
+    # If non-empty, only these pileup branches ("friendlyClassName_label_instance",
+    # wildcards allowed) are read from the premixed input
+    pileupInputBranches = cms.untracked.vstring(),
     # Workers
     workers = cms.PSet(
         pileup = cms.PSet(